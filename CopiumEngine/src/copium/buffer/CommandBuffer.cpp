@@ -15,6 +15,9 @@ namespace Copium
       case CommandBufferType::Dynamic:
         commandBuffers.resize(SwapChain::MAX_FRAMES_IN_FLIGHT);
         break;
+      case CommandBufferType::Secondary:
+        InitializeSecondaryCommandBuffers();
+        return;
       default:
         CP_ABORT("Unreachable switch case: %s", ToString(type).c_str());
     }
@@ -30,6 +33,21 @@ namespace Copium
 
   CommandBuffer::~CommandBuffer()
   {
+    if (type == CommandBufferType::Secondary)
+    {
+      // Destroying the pools frees the command buffers
+      std::vector<VkCommandPool> commandPoolsCpy = commandPools;
+      Vulkan::GetDevice().QueueIdleCommand(
+        [commandPoolsCpy]()
+        {
+          for (auto&& commandPool : commandPoolsCpy)
+          {
+            vkDestroyCommandPool(Vulkan::GetDevice(), commandPool, nullptr);
+          }
+        });
+      return;
+    }
+
     std::vector<VkCommandBuffer> commandBuffersCpy = commandBuffers;
     Vulkan::GetDevice().QueueIdleCommand(
       [commandBuffersCpy]()
@@ -56,18 +74,54 @@ namespace Copium
         break;
       case CommandBufferType::Dynamic:
         break;
+      case CommandBufferType::Secondary:
+        CP_ABORT("Secondary command buffers must be begun with a render pass");
       default:
         CP_ABORT("Unreachable switch case: %s", ToString(type).c_str());
     }
 
-    vkResetCommandBuffer(commandBuffers[Vulkan::GetSwapChain().GetFlightIndex()], 0);
-    CP_VK_ASSERT(vkBeginCommandBuffer(commandBuffers[Vulkan::GetSwapChain().GetFlightIndex()], &beginInfo),
-                 "Failed to begin command buffer");
+    vkResetCommandBuffer(commandBuffers[GetIndex()], 0);
+    CP_VK_ASSERT(vkBeginCommandBuffer(commandBuffers[GetIndex()], &beginInfo), "Failed to begin command buffer");
+  }
+
+  void CommandBuffer::Begin(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent)
+  {
+    CP_ASSERT(type == CommandBufferType::Secondary, "Only secondary command buffers can continue a render pass");
+
+    int flightIndex = Vulkan::GetSwapChain().GetFlightIndex();
+    vkResetCommandPool(Vulkan::GetDevice(), commandPools[flightIndex], 0);
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = renderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+    CP_VK_ASSERT(vkBeginCommandBuffer(commandBuffers[flightIndex], &beginInfo),
+                 "Failed to begin secondary command buffer");
+
+    // Dynamic state is not inherited from the primary command buffer
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = extent.width;
+    viewport.height = extent.height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffers[flightIndex], 0, 1, &viewport);
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffers[flightIndex], 0, 1, &scissor);
   }
 
   void CommandBuffer::End()
   {
-    vkEndCommandBuffer(commandBuffers[Vulkan::GetSwapChain().GetFlightIndex()]);
+    vkEndCommandBuffer(commandBuffers[GetIndex()]);
   }
 
   void CommandBuffer::Submit()
@@ -75,15 +129,61 @@ namespace Copium
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffers[Vulkan::GetSwapChain().GetFlightIndex()];
+    submitInfo.pCommandBuffers = &commandBuffers[GetIndex()];
 
     vkQueueSubmit(Vulkan::GetDevice().GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
     // TODO: if singleUse?
     vkQueueWaitIdle(Vulkan::GetDevice().GetGraphicsQueue());
   }
 
+  void CommandBuffer::Execute(const std::vector<const CommandBuffer*>& secondaryCommandBuffers)
+  {
+    CP_ASSERT(type != CommandBufferType::Secondary, "Secondary command buffers cannot execute other command buffers");
+
+    std::vector<VkCommandBuffer> commandBuffersToExecute{secondaryCommandBuffers.size()};
+    for (size_t i = 0; i < secondaryCommandBuffers.size(); i++)
+    {
+      CP_ASSERT(secondaryCommandBuffers[i]->type == CommandBufferType::Secondary,
+                "Only secondary command buffers can be executed");
+      commandBuffersToExecute[i] = *secondaryCommandBuffers[i];
+    }
+    vkCmdExecuteCommands(
+      commandBuffers[GetIndex()], commandBuffersToExecute.size(), commandBuffersToExecute.data());
+  }
+
   CommandBuffer::operator VkCommandBuffer() const
   {
-    return commandBuffers[Vulkan::GetSwapChain().GetFlightIndex()];
+    return commandBuffers[GetIndex()];
+  }
+
+  int CommandBuffer::GetIndex() const
+  {
+    // Single use command buffers are recorded and submitted at once, so they are not duplicated per flight index
+    if (type == CommandBufferType::SingleUse)
+      return 0;
+    return Vulkan::GetSwapChain().GetFlightIndex();
+  }
+
+  void CommandBuffer::InitializeSecondaryCommandBuffers()
+  {
+    commandBuffers.resize(SwapChain::MAX_FRAMES_IN_FLIGHT);
+    commandPools.resize(SwapChain::MAX_FRAMES_IN_FLIGHT);
+    for (int i = 0; i < SwapChain::MAX_FRAMES_IN_FLIGHT; i++)
+    {
+      VkCommandPoolCreateInfo createInfo{};
+      createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+      createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+      createInfo.queueFamilyIndex = Vulkan::GetDevice().GetGraphicsQueueFamily();
+      CP_VK_ASSERT(vkCreateCommandPool(Vulkan::GetDevice(), &createInfo, nullptr, &commandPools[i]),
+                   "Failed to initialize secondary command pool");
+
+      VkCommandBufferAllocateInfo allocateInfo{};
+      allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+      allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+      allocateInfo.commandPool = commandPools[i];
+      allocateInfo.commandBufferCount = 1;
+      CP_VK_ASSERT(vkAllocateCommandBuffers(Vulkan::GetDevice(), &allocateInfo, &commandBuffers[i]),
+                   "Failed to allocate secondary CommandBuffer");
+    }
   }
 }
\ No newline at end of file
@@ -5,17 +5,20 @@
 #include "copium/util/Common.h"
 #include "copium/util/Enum.h"
 
-#define CP_COMMAND_BUFFER_TYPE_ENUMS SingleUse, Dynamic
+#define CP_COMMAND_BUFFER_TYPE_ENUMS SingleUse, Dynamic, Secondary
 CP_ENUM_CREATOR(Copium, CommandBufferType, CP_COMMAND_BUFFER_TYPE_ENUMS);
 
 namespace Copium
 {
+  // Secondary command buffers have their own command pools, which allows them to be recorded on worker threads. They are
+  // executed by a primary command buffer inside a render pass begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
   class CommandBuffer
   {
     CP_DELETE_COPY_AND_MOVE_CTOR(CommandBuffer);
 
   private:
     std::vector<VkCommandBuffer> commandBuffers;
+    std::vector<VkCommandPool> commandPools;  // Only used by secondary command buffers, one per flight index
     const CommandBufferType type;
 
   public:
@@ -23,9 +26,16 @@ namespace Copium
     virtual ~CommandBuffer();
 
     void Begin();
+    // Begins a secondary command buffer which continues the given render pass, also sets the viewport and scissor
+    void Begin(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent);
     void End();
     void Submit();
+    void Execute(const std::vector<const CommandBuffer*>& secondaryCommandBuffers);
 
     operator VkCommandBuffer() const;
+
+  private:
+    int GetIndex() const;
+    void InitializeSecondaryCommandBuffers();
   };
 }
@@ -8,6 +8,8 @@
 namespace Copium
 {
   Framebuffer::Framebuffer(const MetaFile& metaFile)
+    : profilerLabel{"Framebuffer " + metaFile.GetFilePath()},
+      profilerZone{GpuProfiler::NULL_ZONE}
   {
     const MetaFileClass& metaClass = metaFile.GetMetaClass("Framebuffer");
     colorAttachment = AssetRef<ColorAttachment>(Uuid{metaClass.GetValue("rendertexture-uuid")});
@@ -25,7 +27,9 @@ namespace Copium
 
   Framebuffer::Framebuffer(int width, int height, const SamplerCreator& samplerCreator)
     : width{width},
-      height{height}
+      height{height},
+      profilerLabel{"Framebuffer"},
+      profilerZone{GpuProfiler::NULL_ZONE}
   {
     CP_ASSERT(width > 0, "Width of framebuffer is less than 1: %d", width);
     CP_ASSERT(height > 0, "Height of framebuffer is less than 1: %d", height);
@@ -64,8 +68,11 @@ namespace Copium
     InitializeFramebuffers();
   }
 
-  void Framebuffer::Bind(const CommandBuffer& commandBuffer)
+  void Framebuffer::Bind(const CommandBuffer& commandBuffer, VkSubpassContents contents)
   {
+    // The zone spans the whole render pass and is ended in Unbind
+    profilerZone = Vulkan::GetGpuProfiler().BeginZone(commandBuffer, profilerLabel);
+
     std::vector<VkClearValue> clearValues{2};
     clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
     clearValues[1].depthStencil = {1.0f, 0};
@@ -79,7 +86,9 @@ namespace Copium
     renderPassBeginInfo.renderArea.extent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
     renderPassBeginInfo.clearValueCount = clearValues.size();
     renderPassBeginInfo.pClearValues = clearValues.data();
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, contents);
+    if (contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS)
+      return;
 
     VkViewport viewport{};
     viewport.x = 0.0f;
@@ -98,6 +107,8 @@ namespace Copium
   void Framebuffer::Unbind(const CommandBuffer& commandBuffer)
   {
     vkCmdEndRenderPass(commandBuffer);
+    Vulkan::GetGpuProfiler().EndZone(commandBuffer, profilerZone);
+    profilerZone = GpuProfiler::NULL_ZONE;
   }
 
   VkRenderPass Framebuffer::GetRenderPass() const
@@ -5,6 +5,7 @@
 #include "copium/asset/Asset.h"
 #include "copium/asset/AssetRef.h"
 #include "copium/buffer/CommandBuffer.h"
+#include "copium/core/GpuProfiler.h"
 #include "copium/sampler/ColorAttachment.h"
 #include "copium/sampler/DepthAttachment.h"
 #include "copium/util/Common.h"
@@ -23,6 +24,8 @@ namespace Copium
 
     int width;
     int height;
+    std::string profilerLabel;
+    GpuProfiler::ZoneHandle profilerZone;
 
   public:
     Framebuffer(const MetaFile& metaFile);
@@ -30,7 +33,8 @@ namespace Copium
     ~Framebuffer();
 
     void Resize(int width, int height);
-    void Bind(const CommandBuffer& commandBuffer);
+    // Use VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS to only record the render pass through CommandBuffer::Execute
+    void Bind(const CommandBuffer& commandBuffer, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
     void Unbind(const CommandBuffer& commandBuffer);
 
     VkRenderPass GetRenderPass() const;
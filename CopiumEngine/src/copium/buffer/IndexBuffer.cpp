@@ -23,9 +23,14 @@ namespace Copium
     vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
   }
 
-  void IndexBuffer::Draw(const CommandBuffer& commandBuffer, int indices)
+  void IndexBuffer::Draw(const CommandBuffer& commandBuffer, int indices, int vertexOffset)
   {
     CP_ASSERT(indices >= 0 && indices <= indexCount, "amount of indices is out of range");
-    vkCmdDrawIndexed(commandBuffer, indices, 1, 0, 0, 0);
+    vkCmdDrawIndexed(commandBuffer, indices, 1, 0, vertexOffset, 0);
+  }
+
+  void IndexBuffer::DrawInstanced(const CommandBuffer& commandBuffer, int instances)
+  {
+    vkCmdDrawIndexed(commandBuffer, indexCount, instances, 0, 0, 0);
   }
 }
@@ -18,6 +18,7 @@ namespace Copium
 
     void Bind(const CommandBuffer& commandBuffer);
     void Draw(const CommandBuffer& commandBuffer);
-    void Draw(const CommandBuffer& commandBuffer, int indices);
+    void Draw(const CommandBuffer& commandBuffer, int indices, int vertexOffset = 0);
+    void DrawInstanced(const CommandBuffer& commandBuffer, int instances);
   };
 }
\ No newline at end of file
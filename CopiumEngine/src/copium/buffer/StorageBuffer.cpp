@@ -0,0 +1,18 @@
+#include "copium/buffer/StorageBuffer.h"
+
+namespace Copium
+{
+  StorageBuffer::StorageBuffer(VkMemoryPropertyFlags properties, VkDeviceSize size, int count)
+    : Buffer{VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, properties, size, count}
+  {
+  }
+
+  VkDescriptorBufferInfo StorageBuffer::GetDescriptorBufferInfo(int flightIndex) const
+  {
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = handle;
+    bufferInfo.offset = count == 1 ? 0 : (VkDeviceSize)flightIndex * size;
+    bufferInfo.range = size;
+    return bufferInfo;
+  }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include "copium/buffer/Buffer.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Buffer for "layout(set = S, binding = B, std430) readonly buffer" blocks.
+  // A buffer with one element is shared by all frames in flight, otherwise each frame in flight binds its own element
+  class StorageBuffer final : public Buffer
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(StorageBuffer);
+
+  public:
+    StorageBuffer(VkMemoryPropertyFlags properties, VkDeviceSize size, int count);
+
+    VkDescriptorBufferInfo GetDescriptorBufferInfo(int flightIndex) const;
+  };
+}
@@ -0,0 +1,114 @@
+#include "copium/buffer/TransientVertexBuffer.h"
+
+#include "copium/core/Vulkan.h"
+
+namespace Copium
+{
+  TransientVertexBuffer::TransientVertexBuffer(VkDeviceSize chunkSize)
+    : chunkSize{chunkSize},
+      frames{(size_t)SwapChain::MAX_FRAMES_IN_FLIGHT}
+  {
+    for (auto& frame : frames)
+    {
+      AddChunk(frame, chunkSize);
+    }
+  }
+
+  TransientVertexBuffer::~TransientVertexBuffer()
+  {
+    for (auto& frame : frames)
+    {
+      for (auto& chunk : frame.chunks)
+      {
+        chunk.buffer->Unmap();
+      }
+    }
+  }
+
+  TransientVertexBuffer::Allocation TransientVertexBuffer::Reserve(VkDeviceSize minSize, VkDeviceSize maxSize)
+  {
+    CP_ASSERT(minSize <= maxSize, "minSize=%llu is greater than maxSize=%llu", minSize, maxSize);
+
+    std::lock_guard<std::mutex> lock{mutex};
+    Frame& frame = GetCurrentFrame();
+    while (frame.chunks[frame.chunkIndex].size - frame.chunks[frame.chunkIndex].offset < minSize)
+    {
+      frame.chunkIndex++;
+      if (frame.chunkIndex == frame.chunks.size())
+      {
+        AddChunk(frame, std::max(chunkSize, maxSize));
+        break;
+      }
+    }
+
+    Chunk& chunk = frame.chunks[frame.chunkIndex];
+    Allocation allocation{*chunk.buffer,
+                          chunk.offset,
+                          std::min(maxSize, chunk.size - chunk.offset),
+                          chunk.mappedData + chunk.offset};
+    chunk.offset = AlignOffset(chunk, allocation.offset + allocation.size);
+    return allocation;
+  }
+
+  void TransientVertexBuffer::Commit(const Allocation& allocation, VkDeviceSize usedSize)
+  {
+    CP_ASSERT(usedSize <= allocation.size, "Committing more than was reserved");
+
+    std::lock_guard<std::mutex> lock{mutex};
+    Frame& frame = GetCurrentFrame();
+    Chunk& chunk = frame.chunks[frame.chunkIndex];
+    if ((VkBuffer)*chunk.buffer == allocation.buffer &&
+        chunk.offset == AlignOffset(chunk, allocation.offset + allocation.size))
+    {
+      chunk.offset = AlignOffset(chunk, allocation.offset + usedSize);
+    }
+  }
+
+  void TransientVertexBuffer::Reset(int flightIndex)
+  {
+    Frame& frame = frames[flightIndex];
+
+    // Release chunks which weren't needed the last time this frame was used, but keep one spare
+    while (frame.chunks.size() > frame.chunkIndex + 2)
+    {
+      frame.chunks.back().buffer->Unmap();
+      frame.chunks.pop_back();
+    }
+
+    for (auto& chunk : frame.chunks)
+    {
+      chunk.offset = 0;
+    }
+    frame.chunkIndex = 0;
+  }
+
+  void TransientVertexBuffer::Bind(const CommandBuffer& commandBuffer, const Allocation& allocation)
+  {
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &allocation.buffer, &allocation.offset);
+  }
+
+  TransientVertexBuffer::Frame& TransientVertexBuffer::GetCurrentFrame()
+  {
+    return frames[Vulkan::GetSwapChain().GetFlightIndex()];
+  }
+
+  TransientVertexBuffer::Chunk& TransientVertexBuffer::AddChunk(Frame& frame, VkDeviceSize size)
+  {
+    Chunk chunk;
+    chunk.buffer = std::make_unique<Buffer>(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                            size,
+                                            1);
+    chunk.mappedData = (char*)chunk.buffer->Map();
+    chunk.size = size;
+    chunk.offset = 0;
+    frame.chunks.emplace_back(std::move(chunk));
+    return frame.chunks.back();
+  }
+
+  VkDeviceSize TransientVertexBuffer::AlignOffset(const Chunk& chunk, VkDeviceSize offset)
+  {
+    return std::min(chunk.size, (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+  }
+}
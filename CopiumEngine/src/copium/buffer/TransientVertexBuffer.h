@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "copium/buffer/Buffer.h"
+#include "copium/buffer/CommandBuffer.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Persistently mapped vertex memory which is only valid for the current frame in flight.
+  // Renderers reserve space for a batch, write to it and commit the amount they actually used, which makes the memory
+  // usage follow the actual load of the frame. The memory of a frame in flight is reset once its fence has signaled.
+  // Reserve and Commit may be called from multiple threads recording secondary command buffers
+  class TransientVertexBuffer final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(TransientVertexBuffer);
+
+  public:
+    struct Allocation
+    {
+      VkBuffer buffer;
+      VkDeviceSize offset;
+      VkDeviceSize size;
+      void* data;
+    };
+
+  private:
+    static constexpr VkDeviceSize ALIGNMENT = 16;
+
+    struct Chunk
+    {
+      std::unique_ptr<Buffer> buffer;
+      char* mappedData;
+      VkDeviceSize size;
+      VkDeviceSize offset;
+    };
+
+    struct Frame
+    {
+      std::vector<Chunk> chunks;
+      int chunkIndex = 0;
+    };
+
+    VkDeviceSize chunkSize;
+    std::vector<Frame> frames;
+    std::mutex mutex;
+
+  public:
+    TransientVertexBuffer(VkDeviceSize chunkSize);
+    ~TransientVertexBuffer();
+
+    // Reserves at least minSize and at most maxSize bytes, the size of the allocation is the reserved size
+    Allocation Reserve(VkDeviceSize minSize, VkDeviceSize maxSize);
+    // Commits the part of the reservation which was actually written, the rest is given back if nothing has been
+    // reserved after it
+    void Commit(const Allocation& allocation, VkDeviceSize usedSize);
+
+    void Reset(int flightIndex);
+
+    static void Bind(const CommandBuffer& commandBuffer, const Allocation& allocation);
+
+  private:
+    Frame& GetCurrentFrame();
+    Chunk& AddChunk(Frame& frame, VkDeviceSize size);
+    static VkDeviceSize AlignOffset(const Chunk& chunk, VkDeviceSize offset);
+  };
+}
@@ -50,6 +50,11 @@ namespace Copium
     return physicalDevice;
   }
 
+  bool Device::SupportsBindless() const
+  {
+    return bindlessSupported;
+  }
+
   Device::operator VkDevice() const
   {
     return device;
@@ -130,7 +135,7 @@ namespace Copium
 
   void Device::InitializeLogicalDevice()
   {
-    QueueFamiliesQuery query{Vulkan::GetWindow().GetSurface(), physicalDevice};
+    QueueFamiliesQuery query{GetSurface(), physicalDevice};
 
     float queuePriority = 1.0f;
 
@@ -149,8 +154,23 @@ namespace Copium
     VkPhysicalDeviceFeatures deviceFeatures{};
     deviceFeatures.fillModeNonSolid = VK_TRUE;
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+
+    bindlessSupported = CheckBindlessSupport(physicalDevice);
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{};
+    descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    if (bindlessSupported)
+    {
+      deviceExtensions.emplace_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+      descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+      descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+      descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+      descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+    }
+    CP_INFO("Bindless textures: %s", bindlessSupported ? "supported" : "not supported");
+
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = bindlessSupported ? &descriptorIndexingFeatures : nullptr;
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.queueCreateInfoCount = queueCreateInfos.size();
     createInfo.pEnabledFeatures = &deviceFeatures;
@@ -189,13 +209,16 @@ namespace Copium
     if (!deviceFeatures.fillModeNonSolid || !deviceFeatures.samplerAnisotropy)
       return 0;
 
-    QueueFamiliesQuery query{Vulkan::GetWindow().GetSurface(), device};
+    QueueFamiliesQuery query{GetSurface(), device};
     if (!query.AllRequiredFamiliesSupported())
       return 0;
 
     if (!CheckDeviceExtensionSupport(device))
       return 0;
 
+    if (Vulkan::IsHeadless())
+      return priority;
+
     SwapChainSupportDetails details{Vulkan::GetWindow().GetSurface(), device};
     if (!details.Valid())
       return 0;
@@ -227,8 +250,48 @@ namespace Copium
     return true;
   }
 
+  bool Device::CheckBindlessSupport(VkPhysicalDevice device)
+  {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions{extensionCount};
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensions.data());
+
+    bool found = false;
+    for (auto&& extension : extensions)
+    {
+      if (std::strcmp(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, extension.extensionName) == 0)
+      {
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+      return false;
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{};
+    descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    VkPhysicalDeviceFeatures2 deviceFeatures{};
+    deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    deviceFeatures.pNext = &descriptorIndexingFeatures;
+    vkGetPhysicalDeviceFeatures2(device, &deviceFeatures);
+    return descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+           descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+           descriptorIndexingFeatures.descriptorBindingPartiallyBound &&
+           descriptorIndexingFeatures.runtimeDescriptorArray;
+  }
+
   std::vector<const char*> Device::GetRequiredDeviceExtensions()
   {
+    if (Vulkan::IsHeadless())
+      return {};
     return {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
   }
+
+  VkSurfaceKHR Device::GetSurface()
+  {
+    if (Vulkan::IsHeadless())
+      return VK_NULL_HANDLE;
+    return Vulkan::GetWindow().GetSurface();
+  }
 }
@@ -24,6 +24,8 @@ namespace Copium
     VkQueue GetPresentQueue() const;
     VkCommandPool GetCommandPool() const;
     VkPhysicalDevice GetPhysicalDevice() const;
+    // Whether VK_EXT_descriptor_indexing is enabled, which allows a single update-after-bind array of all textures
+    bool SupportsBindless() const;
     operator VkDevice() const;
     uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
     void WaitIdle();
@@ -35,6 +37,7 @@ namespace Copium
     VkPhysicalDevice physicalDevice;
     VkDevice device;
     VkCommandPool commandPool;
+    bool bindlessSupported;
 
     // TODO: Move to SwapChain?
     uint32_t graphicsQueueIndex;
@@ -50,6 +53,8 @@ namespace Copium
     void InitializeCommandPool();
     uint32_t GetPhysicalDevicePriority(VkPhysicalDevice device);
     bool CheckDeviceExtensionSupport(VkPhysicalDevice device);
+    bool CheckBindlessSupport(VkPhysicalDevice device);
     std::vector<const char*> GetRequiredDeviceExtensions();
+    VkSurfaceKHR GetSurface();
   };
 }
@@ -0,0 +1,322 @@
+#include "copium/core/GpuProfiler.h"
+
+#include <algorithm>
+#include <imgui.h>
+#include <iomanip>
+#include <sstream>
+
+#include "copium/core/Vulkan.h"
+#include "copium/util/FileSystem.h"
+
+namespace Copium
+{
+  static std::string EscapeJson(const std::string& str)
+  {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str)
+    {
+      if (c == '"' || c == '\\')
+        escaped += '\\';
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  GpuProfiler::GpuProfiler()
+    : resetCommandBuffer{CommandBufferType::Dynamic}
+  {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(Vulkan::GetDevice().GetPhysicalDevice(), &properties);
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(Vulkan::GetDevice().GetPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(
+      Vulkan::GetDevice().GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+    uint32_t validBits = queueFamilies[Vulkan::GetDevice().GetGraphicsQueueFamily()].timestampValidBits;
+    timestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t{1} << validBits) - 1;
+    timestampsSupported = validBits > 0 && timestampPeriod > 0.0;
+    CP_INFO("Gpu timestamps: %s", timestampsSupported ? "supported" : "not supported");
+
+    InitializeQueryPools();
+  }
+
+  GpuProfiler::~GpuProfiler()
+  {
+    for (auto&& frame : frames)
+    {
+      vkDestroyQueryPool(Vulkan::GetDevice(), frame.queryPool, nullptr);
+    }
+  }
+
+  void GpuProfiler::BeginFrame()
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    Frame& frame = frames[Vulkan::GetSwapChain().GetFlightIndex()];
+    frame.zones.clear();
+    frame.queryCount = 0;
+    frame.frame = Vulkan::GetSwapChain().GetFrameCount();
+    frame.recorded = true;
+    for (auto&& thread : threads)
+    {
+      thread.second.depth = 0;
+    }
+    if (!timestampsSupported)
+      return;
+
+    resetCommandBuffer.Begin();
+    vkCmdResetQueryPool(resetCommandBuffer, frame.queryPool, 0, MAX_NUM_QUERIES);
+    resetCommandBuffer.End();
+  }
+
+  VkCommandBuffer GpuProfiler::GetResetCommandBuffer() const
+  {
+    if (!timestampsSupported)
+      return VK_NULL_HANDLE;
+    return resetCommandBuffer;
+  }
+
+  void GpuProfiler::Collect(int flightIndex)
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    Frame& frame = frames[flightIndex];
+    if (!frame.recorded)
+      return;
+    frame.recorded = false;
+
+    // Every query is followed by its availability, so unfinished queries are skipped instead of waited on
+    std::vector<uint64_t> results(frame.queryCount * 2);
+    if (frame.queryCount > 0)
+    {
+      vkGetQueryPoolResults(Vulkan::GetDevice(),
+                            frame.queryPool,
+                            0,
+                            frame.queryCount,
+                            results.size() * sizeof(uint64_t),
+                            results.data(),
+                            2 * sizeof(uint64_t),
+                            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    }
+
+    uint64_t firstTimestamp = UINT64_MAX;
+    for (uint32_t i = 0; i < frame.queryCount; i++)
+    {
+      if (results[i * 2 + 1] != 0)
+        firstTimestamp = std::min(firstTimestamp, results[i * 2] & timestampMask);
+    }
+
+    ProfilerFrame profilerFrame{frame.frame, {}};
+    profilerFrame.zones.reserve(frame.zones.size());
+    for (auto&& zone : frame.zones)
+    {
+      if (!zone.ended)
+        continue;
+
+      ProfilerZone profilerZone{
+        zone.name, zone.thread, zone.depth, zone.cpuStart, zone.cpuEnd - zone.cpuStart, -1.0, 0.0};
+      if (zone.queryIndex >= 0 && results[zone.queryIndex * 2 + 1] != 0 && results[zone.queryIndex * 2 + 3] != 0)
+      {
+        uint64_t begin = results[zone.queryIndex * 2] & timestampMask;
+        uint64_t end = results[zone.queryIndex * 2 + 2] & timestampMask;
+        profilerZone.gpuStart = (begin - firstTimestamp) * timestampPeriod * 1e-9;
+        profilerZone.gpuDuration = (end - begin) * timestampPeriod * 1e-9;
+      }
+      profilerFrame.zones.emplace_back(std::move(profilerZone));
+    }
+    history.emplace_back(std::move(profilerFrame));
+    if (history.size() > MAX_NUM_HISTORY_FRAMES)
+      history.pop_front();
+  }
+
+  GpuProfiler::ZoneHandle GpuProfiler::BeginZone(const std::string& name)
+  {
+    return BeginZone(nullptr, name);
+  }
+
+  GpuProfiler::ZoneHandle GpuProfiler::BeginZone(const CommandBuffer& commandBuffer, const std::string& name)
+  {
+    return BeginZone(&commandBuffer, name);
+  }
+
+  void GpuProfiler::EndZone(ZoneHandle zone)
+  {
+    EndZone(nullptr, zone);
+  }
+
+  void GpuProfiler::EndZone(const CommandBuffer& commandBuffer, ZoneHandle zone)
+  {
+    EndZone(&commandBuffer, zone);
+  }
+
+  const ProfilerFrame* GpuProfiler::GetLatestFrame() const
+  {
+    if (history.empty())
+      return nullptr;
+    return &history.back();
+  }
+
+  void GpuProfiler::ImGuiRender() const
+  {
+    if (Vulkan::IsHeadless())
+      return;
+
+    const ProfilerFrame* frame = GetLatestFrame();
+    ImGui::Begin("Profiler");
+    if (!frame)
+    {
+      ImGui::Text("No frames have been profiled");
+      ImGui::End();
+      return;
+    }
+
+    ImGui::Text("Frame %llu", static_cast<unsigned long long>(frame->frame));
+    if (ImGui::BeginTable("Zones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders))
+    {
+      ImGui::TableSetupColumn("Zone");
+      ImGui::TableSetupColumn("Thread");
+      ImGui::TableSetupColumn("Cpu (ms)");
+      ImGui::TableSetupColumn("Gpu (ms)");
+      ImGui::TableHeadersRow();
+      for (auto&& zone : frame->zones)
+      {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%*s%s", zone.depth * 2, "", zone.name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%d", zone.thread);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", zone.cpuDuration * 1000.0);
+        ImGui::TableNextColumn();
+        if (zone.gpuStart >= 0.0)
+          ImGui::Text("%.3f", zone.gpuDuration * 1000.0);
+        else
+          ImGui::TextDisabled("-");
+      }
+      ImGui::EndTable();
+    }
+    ImGui::End();
+  }
+
+  void GpuProfiler::ExportTrace(const std::string& filename) const
+  {
+    // The gpu clock is not related to the cpu clock, so the gpu zones of a frame are aligned to its first cpu zone
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    // Every cpu thread gets its own track, since zones only nest within a thread
+    int numThreads = 0;
+    for (auto&& frame : history)
+    {
+      for (auto&& zone : frame.zones)
+      {
+        numThreads = std::max(numThreads, zone.thread + 1);
+      }
+    }
+    ss << "{\"traceEvents\":[";
+    ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Gpu\"}}";
+    for (int i = 0; i < numThreads; i++)
+    {
+      ss << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i + 1
+         << ",\"args\":{\"name\":\"Cpu " << i << "\"}}";
+    }
+    for (auto&& frame : history)
+    {
+      if (frame.zones.empty())
+        continue;
+
+      double frameStart = frame.zones.front().cpuStart;
+      for (auto&& zone : frame.zones)
+      {
+        std::string name = EscapeJson(zone.name);
+        ss << ",{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.thread + 1
+           << ",\"ts\":" << zone.cpuStart * 1e6 << ",\"dur\":" << zone.cpuDuration * 1e6
+           << ",\"args\":{\"frame\":" << frame.frame << "}}";
+        if (zone.gpuStart < 0.0)
+          continue;
+        ss << ",{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"
+           << (frameStart + zone.gpuStart) * 1e6 << ",\"dur\":" << zone.gpuDuration * 1e6
+           << ",\"args\":{\"frame\":" << frame.frame << "}}";
+      }
+    }
+    ss << "]}";
+    FileSystem::WriteFile(filename, ss.str());
+  }
+
+  GpuProfiler::ZoneHandle GpuProfiler::BeginZone(const CommandBuffer* commandBuffer, const std::string& name)
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    Frame& frame = frames[Vulkan::GetSwapChain().GetFlightIndex()];
+    if (!frame.recorded || frame.frame != Vulkan::GetSwapChain().GetFrameCount())
+      return NULL_ZONE;
+
+    // Zones recorded on other threads don't nest within the zones of this thread
+    Thread& thread = threads.emplace(std::this_thread::get_id(), Thread{static_cast<int>(threads.size()), 0})
+                       .first->second;
+    PendingZone& zone =
+      frame.zones.emplace_back(PendingZone{name, thread.index, thread.depth, timer.Elapsed(), 0.0, -1, false});
+    thread.depth++;
+    if (commandBuffer && timestampsSupported && frame.queryCount + 2 <= MAX_NUM_QUERIES)
+    {
+      zone.queryIndex = frame.queryCount;
+      frame.queryCount += 2;
+      vkCmdWriteTimestamp(*commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.queryPool, zone.queryIndex);
+    }
+    return ZoneHandle{frame.frame, static_cast<int>(frame.zones.size() - 1)};
+  }
+
+  void GpuProfiler::EndZone(const CommandBuffer* commandBuffer, ZoneHandle handle)
+  {
+    if (handle.index == NULL_ZONE.index)
+      return;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    // The frame has ended since the zone was begun, so its zones and thread depths have already been reset
+    Frame& frame = frames[Vulkan::GetSwapChain().GetFlightIndex()];
+    if (!frame.recorded || frame.frame != handle.frame)
+      return;
+
+    PendingZone& zone = frame.zones[handle.index];
+    if (commandBuffer && zone.queryIndex >= 0)
+      vkCmdWriteTimestamp(*commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.queryPool, zone.queryIndex + 1);
+    zone.cpuEnd = timer.Elapsed();
+    zone.ended = true;
+    auto it = threads.find(std::this_thread::get_id());
+    if (it != threads.end())
+      it->second.depth = std::max(it->second.depth - 1, 0);
+  }
+
+  void GpuProfiler::InitializeQueryPools()
+  {
+    frames.resize(SwapChain::MAX_FRAMES_IN_FLIGHT);
+    for (auto&& frame : frames)
+    {
+      VkQueryPoolCreateInfo createInfo{};
+      createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+      createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+      createInfo.queryCount = MAX_NUM_QUERIES;
+      CP_VK_ASSERT(vkCreateQueryPool(Vulkan::GetDevice(), &createInfo, nullptr, &frame.queryPool),
+                   "Failed to initialize timestamp query pool");
+    }
+  }
+
+  GpuProfilerScope::GpuProfilerScope(const std::string& name)
+    : commandBuffer{nullptr},
+      zone{Vulkan::GetGpuProfiler().BeginZone(name)}
+  {
+  }
+
+  GpuProfilerScope::GpuProfilerScope(const CommandBuffer& commandBuffer, const std::string& name)
+    : commandBuffer{&commandBuffer},
+      zone{Vulkan::GetGpuProfiler().BeginZone(commandBuffer, name)}
+  {
+  }
+
+  GpuProfilerScope::~GpuProfilerScope()
+  {
+    if (commandBuffer)
+      Vulkan::GetGpuProfiler().EndZone(*commandBuffer, zone);
+    else
+      Vulkan::GetGpuProfiler().EndZone(zone);
+  }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "copium/buffer/CommandBuffer.h"
+#include "copium/util/Common.h"
+#include "copium/util/Timer.h"
+
+namespace Copium
+{
+  struct ProfilerZone
+  {
+    std::string name;
+    int thread;          // Index of the thread which recorded the zone, in the order the threads first recorded one
+    int depth;           // Nesting depth within the thread
+    double cpuStart;     // Seconds since the profiler was created
+    double cpuDuration;  // Seconds
+    double gpuStart;     // Seconds relative to the first timestamp of the frame, negative if there is no gpu time
+    double gpuDuration;  // Seconds
+  };
+
+  struct ProfilerFrame
+  {
+    uint64_t frame;
+    std::vector<ProfilerZone> zones;
+  };
+
+  // Measures labeled zones on the cpu and, if a command buffer is given, on the gpu using timestamp queries.
+  // Every frame in flight has its own query pool, which is read back without waiting and reset once the fence of the
+  // frame in flight has signaled in SwapChain::BeginPresent. The reset is recorded in a command buffer of the profiler,
+  // which SwapChain::SubmitToGraphicsQueue submits ahead of the frame, so gpu zones must be recorded in the command
+  // buffer of the frame. The latest frame is shown in a window by ImGuiInstance::End, and the application decides when
+  // to call ExportTrace
+  class GpuProfiler final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(GpuProfiler);
+
+  public:
+    // Identifies a zone within its frame, zones which are not ended within the frame they began in are discarded
+    struct ZoneHandle
+    {
+      uint64_t frame;
+      int index;
+    };
+
+    static constexpr ZoneHandle NULL_ZONE{0, -1};
+
+  private:
+    static constexpr uint32_t MAX_NUM_QUERIES = 1024;
+    static constexpr size_t MAX_NUM_HISTORY_FRAMES = 120;
+
+    struct PendingZone
+    {
+      std::string name;
+      int thread;
+      int depth;
+      double cpuStart;
+      double cpuEnd;
+      int32_t queryIndex;  // Begin timestamp, the end timestamp is the next query. Negative if there is no gpu time
+      bool ended;
+    };
+
+    struct Frame
+    {
+      VkQueryPool queryPool;
+      std::vector<PendingZone> zones;
+      uint32_t queryCount = 0;
+      uint64_t frame = 0;
+      bool recorded = false;
+    };
+
+    struct Thread
+    {
+      int index;
+      int depth;
+    };
+
+    std::vector<Frame> frames;
+    CommandBuffer resetCommandBuffer;
+    std::deque<ProfilerFrame> history;
+    Timer timer;
+    double timestampPeriod;  // Nanoseconds per tick
+    uint64_t timestampMask;
+    bool timestampsSupported;
+    std::unordered_map<std::thread::id, Thread> threads;
+    std::mutex mutex;
+
+  public:
+    GpuProfiler();
+    ~GpuProfiler();
+
+    // Reads back the results of the frame in flight, its fence must have signaled
+    void Collect(int flightIndex);
+    // Records the reset of the query pool of the frame in flight, called by the SwapChain once the frame has begun.
+    // Zones begun before it belong to the previous frame and are not recorded
+    void BeginFrame();
+    // Submitted before the command buffer of the frame, VK_NULL_HANDLE if there is nothing to reset
+    VkCommandBuffer GetResetCommandBuffer() const;
+
+    ZoneHandle BeginZone(const std::string& name);
+    ZoneHandle BeginZone(const CommandBuffer& commandBuffer, const std::string& name);
+    void EndZone(ZoneHandle zone);
+    void EndZone(const CommandBuffer& commandBuffer, ZoneHandle zone);
+
+    // Zones of the latest frame which has been read back
+    const ProfilerFrame* GetLatestFrame() const;
+    void ImGuiRender() const;
+    // Writes the recorded history in the chrome trace event format, viewable in chrome://tracing or Perfetto
+    void ExportTrace(const std::string& filename) const;
+
+  private:
+    ZoneHandle BeginZone(const CommandBuffer* commandBuffer, const std::string& name);
+    void EndZone(const CommandBuffer* commandBuffer, ZoneHandle zone);
+    void InitializeQueryPools();
+  };
+
+  class GpuProfilerScope final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(GpuProfilerScope);
+
+  private:
+    const CommandBuffer* commandBuffer;
+    GpuProfiler::ZoneHandle zone;
+
+  public:
+    GpuProfilerScope(const std::string& name);
+    GpuProfilerScope(const CommandBuffer& commandBuffer, const std::string& name);
+    ~GpuProfilerScope();
+  };
+}
@@ -33,11 +33,13 @@ namespace Copium
 
   void ImGuiInstance::End()
   {
+    Vulkan::GetGpuProfiler().ImGuiRender();
     ImGui::EndFrame();
   }
 
   void ImGuiInstance::Render(CommandBuffer& commandBuffer)
   {
+    GpuProfilerScope profilerScope{commandBuffer, "ImGui"};
     ImGui::Render();
     ImDrawData* draw_data = ImGui::GetDrawData();
     ImGui_ImplVulkan_RenderDrawData(draw_data, commandBuffer);
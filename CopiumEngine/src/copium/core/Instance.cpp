@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 
+#include "copium/core/Vulkan.h"
 #include "copium/util/Common.h"
 
 namespace Copium
@@ -67,11 +68,14 @@ namespace Copium
 
   std::vector<const char*> Instance::GetRequiredExtensions()
   {
-    uint32_t glfwExtensionCount;
-    const char** glfwExtensions;
-    glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-    std::vector<const char*> extensions{glfwExtensions, glfwExtensions + glfwExtensionCount};
+    std::vector<const char*> extensions{};
+    if (!Vulkan::IsHeadless())
+    {
+      uint32_t glfwExtensionCount;
+      const char** glfwExtensions;
+      glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+      extensions.insert(extensions.end(), glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
 
     debugMessenger->AddRequiredExtensions(&extensions);
 
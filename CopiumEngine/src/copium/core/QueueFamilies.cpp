@@ -18,8 +18,12 @@ namespace Copium
       {
         graphicsFamily = i;
       }
+      // Without a surface nothing is presented, the graphics queue is used for everything
       VkBool32 presentSupport = false;
-      vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+      if (surface == VK_NULL_HANDLE)
+        presentSupport = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+      else
+        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
       if (presentSupport)
       {
         presentFamily = i;
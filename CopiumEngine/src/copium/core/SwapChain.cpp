@@ -2,6 +2,7 @@
 
 #include "copium/core/QueueFamilies.h"
 #include "copium/core/Vulkan.h"
+#include "copium/sampler/GlyphCache.h"
 #include "copium/sampler/Image.h"
 
 namespace Copium
@@ -36,7 +37,9 @@ namespace Copium
 
   SwapChain::SwapChain()
     : flightIndex{0},
-      resizeFramebuffer{false}
+      frameCount{0},
+      resizeFramebuffer{false},
+      headless{false}
   {
     Initialize();
     InitializeImageViews();
@@ -46,6 +49,24 @@ namespace Copium
     InitializeSyncObjects();
   }
 
+  SwapChain::SwapChain(int width, int height)
+    : handle{VK_NULL_HANDLE},
+      imageFormat{VK_FORMAT_R8G8B8A8_UNORM},
+      extent{static_cast<uint32_t>(width), static_cast<uint32_t>(height)},
+      imageIndex{0},
+      resizeFramebuffer{false},
+      headless{true},
+      flightIndex{0},
+      frameCount{0}
+  {
+    InitializeHeadlessImages();
+    InitializeImageViews();
+    InitializeDepthAttachment();
+    InitializeRenderPass();
+    InitializeFramebuffers();
+    InitializeSyncObjects();
+  }
+
   SwapChain::~SwapChain()
   {
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
@@ -62,7 +83,7 @@ namespace Copium
     vkDestroyRenderPass(Vulkan::GetDevice(), renderPass, nullptr);
   }
 
-  void SwapChain::BeginFrameBuffer(const CommandBuffer& commandBuffer) const
+  void SwapChain::BeginFrameBuffer(const CommandBuffer& commandBuffer, VkSubpassContents contents) const
   {
     std::vector<VkClearValue> clearValues{2};
     clearValues[0].color = {{0.02f, 0.02f, 0.02f, 1.0f}};
@@ -76,7 +97,9 @@ namespace Copium
     renderPassBeginInfo.renderArea.extent = extent;
     renderPassBeginInfo.clearValueCount = clearValues.size();
     renderPassBeginInfo.pClearValues = clearValues.data();
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, contents);
+    if (contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS)
+      return;
 
     VkViewport viewport{};
     viewport.x = 0.0f;
@@ -120,6 +143,19 @@ namespace Copium
   bool SwapChain::BeginPresent()
   {
     vkWaitForFences(Vulkan::GetDevice(), 1, &inFlightFences[flightIndex], VK_TRUE, UINT64_MAX);
+    // The GPU is done with the transient vertices of this frame in flight
+    Vulkan::GetTransientVertexBuffer().Reset(flightIndex);
+    Vulkan::GetGpuProfiler().Collect(flightIndex);
+    GlyphCache::UpdateAll();
+
+    if (headless)
+    {
+      // The offscreen images are owned per flight, so the fence above guards the image as well
+      imageIndex = flightIndex;
+      vkResetFences(Vulkan::GetDevice(), 1, &inFlightFences[flightIndex]);
+      Vulkan::GetGpuProfiler().BeginFrame();
+      return true;
+    }
 
     VkResult result = vkAcquireNextImageKHR(
       Vulkan::GetDevice(), handle, UINT64_MAX, imageAvailableSemaphores[flightIndex], VK_NULL_HANDLE, &imageIndex);
@@ -129,21 +165,27 @@ namespace Copium
       return false;
     }
     vkResetFences(Vulkan::GetDevice(), 1, &inFlightFences[flightIndex]);
+    Vulkan::GetGpuProfiler().BeginFrame();
     return true;
   }
 
   void SwapChain::SubmitToGraphicsQueue(const CommandBuffer& commandBuffer)
   {
-    VkCommandBuffer cmd = commandBuffer;
+    // The query pool reset of the profiler has to execute before the timestamps written by the frame
+    std::vector<VkCommandBuffer> commandBuffers;
+    VkCommandBuffer resetCommandBuffer = Vulkan::GetGpuProfiler().GetResetCommandBuffer();
+    if (resetCommandBuffer != VK_NULL_HANDLE)
+      commandBuffers.emplace_back(resetCommandBuffer);
+    commandBuffers.emplace_back(commandBuffer);
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.waitSemaphoreCount = headless ? 0 : 1;
     submitInfo.pWaitSemaphores = &imageAvailableSemaphores[flightIndex];
     submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.commandBufferCount = commandBuffers.size();
+    submitInfo.pCommandBuffers = commandBuffers.data();
+    submitInfo.signalSemaphoreCount = headless ? 0 : 1;
     submitInfo.pSignalSemaphores = &renderFinishedSemaphores[imageIndex];
 
     CP_VK_ASSERT(vkQueueSubmit(Vulkan::GetDevice().GetGraphicsQueue(), 1, &submitInfo, inFlightFences[flightIndex]),
@@ -152,6 +194,13 @@ namespace Copium
 
   void SwapChain::EndPresent()
   {
+    if (headless)
+    {
+      flightIndex = (flightIndex + 1) % MAX_FRAMES_IN_FLIGHT;
+      frameCount++;
+      return;
+    }
+
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     presentInfo.waitSemaphoreCount = 1;
@@ -169,6 +218,7 @@ namespace Copium
     }
 
     flightIndex = (flightIndex + 1) % MAX_FRAMES_IN_FLIGHT;
+    frameCount++;
   }
 
   void SwapChain::ResizeFramebuffer()
@@ -178,6 +228,10 @@ namespace Copium
 
   void SwapChain::Recreate()
   {
+    // The offscreen images have a fixed size
+    if (headless)
+      return;
+
     int width = 0;
     int height = 0;
     glfwGetFramebufferSize(Vulkan::GetWindow().GetWindow(), &width, &height);
@@ -202,11 +256,38 @@ namespace Copium
     return flightIndex;
   }
 
+  uint64_t SwapChain::GetFrameCount() const
+  {
+    return frameCount;
+  }
+
   int SwapChain::GetImageCount() const
   {
     return images.size();
   }
 
+  std::vector<uint8_t> SwapChain::ReadPixels() const
+  {
+    CP_ASSERT(headless, "Pixels can only be read from a headless swap chain");
+    CP_ASSERT(frameCount > 0, "No frame has been presented yet");
+
+    // Wait until the last presented frame is fully rendered before copying it
+    Vulkan::GetDevice().WaitIdle();
+    uint32_t lastImageIndex = (flightIndex + MAX_FRAMES_IN_FLIGHT - 1) % MAX_FRAMES_IN_FLIGHT;
+    VkDeviceSize bufferSize = extent.width * extent.height * 4;
+    Buffer stagingBuffer{VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         bufferSize,
+                         1};
+    Image::CopyImageToBuffer(images[lastImageIndex], stagingBuffer, extent.width, extent.height);
+
+    std::vector<uint8_t> pixels(bufferSize);
+    void* data = stagingBuffer.Map();
+    memcpy(pixels.data(), data, bufferSize);
+    stagingBuffer.Unmap();
+    return pixels;
+  }
+
   void SwapChain::Initialize()
   {
     SwapChainSupportDetails swapChainSupport{Vulkan::GetWindow().GetSurface(), Vulkan::GetDevice().GetPhysicalDevice()};
@@ -259,6 +340,23 @@ namespace Copium
     vkGetSwapchainImagesKHR(Vulkan::GetDevice(), handle, &imageCount, images.data());
   }
 
+  void SwapChain::InitializeHeadlessImages()
+  {
+    images.resize(MAX_FRAMES_IN_FLIGHT);
+    imageMemories.resize(MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < images.size(); i++)
+    {
+      Image::InitializeImage(extent.width,
+                             extent.height,
+                             imageFormat,
+                             VK_IMAGE_TILING_OPTIMAL,
+                             VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                             &images[i],
+                             &imageMemories[i]);
+    }
+  }
+
   void SwapChain::InitializeImageViews()
   {
     imageViews.resize(images.size());
@@ -283,7 +381,7 @@ namespace Copium
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkAttachmentDescription depthAttachment{};
     depthAttachment.format = Image::SelectDepthFormat();
@@ -391,6 +489,15 @@ namespace Copium
     {
       vkDestroyImageView(Vulkan::GetDevice(), swapChainImageView, nullptr);
     }
+    if (headless)
+    {
+      for (size_t i = 0; i < images.size(); i++)
+      {
+        vkDestroyImage(Vulkan::GetDevice(), images[i], nullptr);
+        vkFreeMemory(Vulkan::GetDevice(), imageMemories[i], nullptr);
+      }
+      return;
+    }
     vkDestroySwapchainKHR(Vulkan::GetDevice(), handle, nullptr);
   }
 
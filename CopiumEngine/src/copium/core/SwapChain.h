@@ -36,20 +36,27 @@ namespace Copium
     std::unique_ptr<DepthAttachment> depthAttachment;
     std::vector<VkImageView> imageViews;
     std::vector<VkImage> images;
+    std::vector<VkDeviceMemory> imageMemories;
     std::vector<VkFramebuffer> framebuffers;
     uint32_t imageIndex;
     bool resizeFramebuffer;
+    bool headless;
 
     int flightIndex;
+    uint64_t frameCount;
     std::vector<VkSemaphore> imageAvailableSemaphores;
     std::vector<VkSemaphore> renderFinishedSemaphores;
     std::vector<VkFence> inFlightFences;
 
   public:
     SwapChain();
+    // Headless swap chain which renders into offscreen images that are never presented
+    SwapChain(int width, int height);
     ~SwapChain();
 
-    void BeginFrameBuffer(const CommandBuffer& commandBuffer) const;
+    // Use VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS to only record the render pass through CommandBuffer::Execute
+    void BeginFrameBuffer(const CommandBuffer& commandBuffer,
+                          VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE) const;
     void EndFrameBuffer(const CommandBuffer& commandBuffer) const;
     VkSwapchainKHR GetHandle() const;
     VkRenderPass GetRenderPass() const;
@@ -62,10 +69,15 @@ namespace Copium
     void Recreate();
 
     int GetFlightIndex() const;
+    // Number of frames presented so far
+    uint64_t GetFrameCount() const;
     int GetImageCount() const;
+    // Reads back the last presented frame as RGBA8, only available in headless mode
+    std::vector<uint8_t> ReadPixels() const;
 
   private:
     void Initialize();
+    void InitializeHeadlessImages();
     void InitializeImageViews();
     void InitializeDepthAttachment();
     void InitializeRenderPass();
@@ -15,22 +15,54 @@ namespace Copium
   std::unique_ptr<Device> Vulkan::device;
   std::unique_ptr<SwapChain> Vulkan::swapChain;
   std::unique_ptr<ImGuiInstance> Vulkan::imGuiInstance;
+  std::unique_ptr<TransientVertexBuffer> Vulkan::transientVertexBuffer;
+  std::unique_ptr<BindlessDescriptorSet> Vulkan::bindlessDescriptorSet;
+  std::unique_ptr<TextureAtlas> Vulkan::textureAtlas;
+  std::unique_ptr<GpuProfiler> Vulkan::gpuProfiler;
   AssetHandle<Texture2D> Vulkan::emptyTexture2D;
   AssetHandle<Texture2D> Vulkan::whiteTexture2D;
+  bool Vulkan::headless = false;
 
   void Vulkan::Initialize()
+  {
+    InitializeVulkan(false, 0, 0);
+  }
+
+  void Vulkan::InitializeHeadless(int width, int height)
+  {
+    InitializeVulkan(true, width, height);
+  }
+
+  void Vulkan::InitializeVulkan(bool headless, int width, int height)
   {
     Timer timer;
     timer.Start();
 
-    glfwSetErrorCallback(glfw_error_callback);
-    CP_ASSERT(glfwInit() == GLFW_TRUE, "Failed to initialize the glfw context");
+    Vulkan::headless = headless;
+    if (!headless)
+    {
+      glfwSetErrorCallback(glfw_error_callback);
+      CP_ASSERT(glfwInit() == GLFW_TRUE, "Failed to initialize the glfw context");
+    }
 
     instance = std::make_unique<Instance>("Copium Engine");
-    window = std::make_unique<Window>("Copium Engine", 1440, 810, WindowMode::Windowed);
+    if (!headless)
+      window = std::make_unique<Window>("Copium Engine", 1440, 810, WindowMode::Windowed);
     device = std::make_unique<Device>();
-    swapChain = std::make_unique<SwapChain>();
-    imGuiInstance = std::make_unique<ImGuiInstance>();
+    if (headless)
+    {
+      swapChain = std::make_unique<SwapChain>(width, height);
+    }
+    else
+    {
+      swapChain = std::make_unique<SwapChain>();
+      imGuiInstance = std::make_unique<ImGuiInstance>();
+    }
+    transientVertexBuffer = std::make_unique<TransientVertexBuffer>(8 * 1024 * 1024);
+    if (device->SupportsBindless())
+      bindlessDescriptorSet = std::make_unique<BindlessDescriptorSet>();
+    textureAtlas = std::make_unique<TextureAtlas>();
+    gpuProfiler = std::make_unique<GpuProfiler>();
     CP_INFO("Initialized Vulkan in %f seconds", timer.Elapsed());
 
     timer.Start();
@@ -57,8 +89,12 @@ namespace Copium
     whiteTexture2D.UnloadAsset();
     AssetManager::UnregisterAssetDir("assets/");
     AssetManager::Cleanup();
+    textureAtlas.reset();
     imGuiInstance.reset();
     device->WaitIdle();
+    transientVertexBuffer.reset();
+    bindlessDescriptorSet.reset();
+    gpuProfiler.reset();
     swapChain.reset();
     device->CleanupIdleQueue();
     device.reset();
@@ -73,6 +109,7 @@ namespace Copium
 
   Window& Vulkan::GetWindow()
   {
+    CP_ASSERT(window, "There is no window in headless mode");
     return *window;
   }
 
@@ -88,9 +125,30 @@ namespace Copium
 
   ImGuiInstance& Vulkan::GetImGuiInstance()
   {
+    CP_ASSERT(imGuiInstance, "ImGui is not available in headless mode");
     return *imGuiInstance;
   }
 
+  TransientVertexBuffer& Vulkan::GetTransientVertexBuffer()
+  {
+    return *transientVertexBuffer;
+  }
+
+  BindlessDescriptorSet& Vulkan::GetBindlessDescriptorSet()
+  {
+    return *bindlessDescriptorSet;
+  }
+
+  TextureAtlas& Vulkan::GetTextureAtlas()
+  {
+    return *textureAtlas;
+  }
+
+  GpuProfiler& Vulkan::GetGpuProfiler()
+  {
+    return *gpuProfiler;
+  }
+
   AssetHandle<Texture2D> Vulkan::GetWhiteTexture2D()
   {
     return whiteTexture2D;
@@ -103,7 +161,12 @@ namespace Copium
 
   bool Vulkan::Valid()
   {
-    return instance && window && device && swapChain;
+    return instance && (window || headless) && device && swapChain;
+  }
+
+  bool Vulkan::IsHeadless()
+  {
+    return headless;
   }
 
   void Vulkan::glfw_error_callback(int error, const char* description)
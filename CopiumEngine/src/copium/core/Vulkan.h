@@ -3,12 +3,16 @@
 #include <memory>
 
 #include "copium/asset/AssetHandle.h"
+#include "copium/buffer/TransientVertexBuffer.h"
 #include "copium/core/Device.h"
+#include "copium/core/GpuProfiler.h"
 #include "copium/core/ImGuiInstance.h"
 #include "copium/core/Instance.h"
 #include "copium/core/SwapChain.h"
 #include "copium/core/Window.h"
+#include "copium/pipeline/BindlessDescriptorSet.h"
 #include "copium/sampler/Texture2D.h"
+#include "copium/sampler/TextureAtlas.h"
 #include "copium/util/Common.h"
 
 namespace Copium
@@ -23,23 +27,38 @@ namespace Copium
     static std::unique_ptr<Device> device;
     static std::unique_ptr<SwapChain> swapChain;
     static std::unique_ptr<ImGuiInstance> imGuiInstance;
+    static std::unique_ptr<TransientVertexBuffer> transientVertexBuffer;
+    static std::unique_ptr<BindlessDescriptorSet> bindlessDescriptorSet;
+    static std::unique_ptr<TextureAtlas> textureAtlas;
+    static std::unique_ptr<GpuProfiler> gpuProfiler;
 
     static AssetHandle<Texture2D> emptyTexture2D;
     static AssetHandle<Texture2D> whiteTexture2D;
+    static bool headless;
 
   public:
     static void Initialize();
+    // Renders into offscreen images instead of a window and skips ImGui, so that no display is needed.
+    // Works with software implementations such as lavapipe, the rendered frames are read with SwapChain::ReadPixels
+    static void InitializeHeadless(int width, int height);
     static void Destroy();
     static Instance& GetInstance();
     static Window& GetWindow();
     static Device& GetDevice();
     static SwapChain& GetSwapChain();
     static ImGuiInstance& GetImGuiInstance();
+    static TransientVertexBuffer& GetTransientVertexBuffer();
+    // Only valid if Device::SupportsBindless
+    static BindlessDescriptorSet& GetBindlessDescriptorSet();
+    static TextureAtlas& GetTextureAtlas();
+    static GpuProfiler& GetGpuProfiler();
     static bool Valid();
+    static bool IsHeadless();
     static AssetHandle<Texture2D> GetWhiteTexture2D();
     static AssetHandle<Texture2D> GetEmptyTexture2D();
 
   private:
+    static void InitializeVulkan(bool headless, int width, int height);
     static void glfw_error_callback(int error, const char* description);
   };
 }
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Opt-in to column (SoA) storage for a component, every field of the component should be listed
+//   CP_COMPONENT_COLUMNS(Position, &Position::x, &Position::y);
+#define CP_COMPONENT_COLUMNS(Component, ...)                  \
+  template <>                                                 \
+  struct Copium::ComponentColumns<Component>                  \
+  {                                                           \
+    using Fields = Copium::ColumnFields<__VA_ARGS__>;         \
+  }
+
+namespace Copium
+{
+  template <typename T>
+  struct MemberPointerTraits;
+
+  template <typename Class, typename Member>
+  struct MemberPointerTraits<Member Class::*>
+  {
+    using class_type = Class;
+    using member_type = Member;
+  };
+
+  template <auto... Fields>
+  struct ColumnFields
+  {
+    using Storage = std::tuple<std::vector<typename MemberPointerTraits<decltype(Fields)>::member_type>...>;
+
+    template <auto Field>
+    static constexpr size_t IndexOf()
+    {
+      constexpr bool matches[] = {std::is_same_v<FieldTag<Field>, FieldTag<Fields>>...};
+      for (size_t i = 0; i < sizeof...(Fields); i++)
+      {
+        if (matches[i])
+          return i;
+      }
+      return sizeof...(Fields);
+    }
+
+  private:
+    template <auto Field>
+    struct FieldTag
+    {
+    };
+  };
+
+  template <typename Component>
+  struct ComponentColumns
+  {
+    using Fields = void;
+  };
+
+  template <typename Component>
+  constexpr bool is_column_component_v = !std::is_same_v<typename ComponentColumns<Component>::Fields, void>;
+}
@@ -0,0 +1,36 @@
+#include "copium/ecs/ComponentMaskSet.h"
+
+namespace Copium
+{
+  const ComponentMask ComponentMaskSet::emptyMask{};
+
+  void ComponentMaskSet::Set(EntityId entity, ComponentId componentId)
+  {
+    if (entity >= masks.size())
+      masks.resize(entity + 1);
+    masks[entity].set(componentId);
+  }
+
+  void ComponentMaskSet::Reset(EntityId entity, ComponentId componentId)
+  {
+    if (entity < masks.size())
+      masks[entity].reset(componentId);
+  }
+
+  const ComponentMask& ComponentMaskSet::Get(EntityId entity) const
+  {
+    if (entity < masks.size())
+      return masks[entity];
+    return emptyMask;
+  }
+
+  bool ComponentMaskSet::Contains(EntityId entity, const ComponentMask& mask) const
+  {
+    return (Get(entity) & mask) == mask;
+  }
+
+  bool ComponentMaskSet::ContainsAny(EntityId entity, const ComponentMask& mask) const
+  {
+    return (Get(entity) & mask).any();
+  }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "copium/ecs/Config.h"
+
+namespace Copium
+{
+  class ComponentMaskSet
+  {
+  private:
+    std::vector<ComponentMask> masks;  // Indexed by the entity id
+    static const ComponentMask emptyMask;
+
+  public:
+    void Set(EntityId entity, ComponentId componentId);
+    void Reset(EntityId entity, ComponentId componentId);
+    const ComponentMask& Get(EntityId entity) const;
+    bool Contains(EntityId entity, const ComponentMask& mask) const;
+    bool ContainsAny(EntityId entity, const ComponentMask& mask) const;
+  };
+}
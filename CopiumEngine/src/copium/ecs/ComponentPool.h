@@ -1,16 +1,21 @@
 #pragma once
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "copium/ecs/ComponentColumns.h"
 #include "copium/ecs/ComponentListener.h"
 #include "copium/ecs/ComponentPoolBase.h"
 #include "copium/ecs/Config.h"
 #include "copium/ecs/EntitySet.h"
 #include "copium/util/Common.h"
+#include "copium/util/Span.h"
 
 namespace Copium
 {
-  template <typename Component>
+  template <typename Component, typename = void>
   class ComponentPool : public ComponentPoolBase
   {
     using Iterator = typename std::vector<Component>::iterator;
@@ -30,7 +35,8 @@ namespace Copium
     std::vector<EntityId> removeQueue;
 
   public:
-    ComponentPool()
+    ComponentPool(ComponentId componentId, ComponentMaskSet& componentMasks)
+      : ComponentPoolBase{componentId, componentMasks}
     {
     }
 
@@ -40,11 +46,6 @@ namespace Copium
         delete listener;
     }
 
-    ComponentPool(EntityId entity, const Component& component)
-    {
-      Emplace(entity, component);
-    }
-
     void Emplace(EntityId entity, const Component& component)
     {
       addQueue.emplace_back(entity, component);
@@ -123,6 +124,25 @@ namespace Copium
       ComponentPool::listener = listener;
     }
 
+    // Insertion sort, since the pool is usually already (nearly) sorted from the previous frame
+    template <typename Compare>
+    void Sort(Compare compare)
+    {
+      for (size_t i = 1; i < components.size(); i++)
+      {
+        for (size_t j = i; j > 0 && compare(components[j], components[j - 1]); j--)
+        {
+          Swap(j, j - 1);
+        }
+      }
+    }
+
+    void Swap(size_t index1, size_t index2)
+    {
+      std::swap(components[index1], components[index2]);
+      entities.Swap(index1, index2);
+    }
+
     Component& operator[](size_t index)
     {
       CP_ASSERT(index < components.size(), "Index Out of Bound Exception");
@@ -165,6 +185,7 @@ namespace Copium
 
       components.push_back(component);
       entities.Emplace(entity);
+      componentMasks.Set(entity, componentId);
       if (listener)
         listener->Added(entity, components.back());
     }
@@ -186,6 +207,7 @@ namespace Copium
         CP_WARN("Entity did not contain component (entity=%u, Component=%s)", entity, typeid(Component).name());
         return;
       }
+      componentMasks.Reset(entity, componentId);
 
       if (listener)
       {
@@ -200,4 +222,351 @@ namespace Copium
       }
     }
   };
+
+  // Empty components (tags) only store membership, no component values are stored or queued
+  template <typename Component>
+  class ComponentPool<Component, std::enable_if_t<std::is_empty_v<Component>>> : public ComponentPoolBase
+  {
+  private:
+    static inline Component tag{};
+    ComponentListener<Component>* listener = nullptr;
+
+    enum class QueueOperation
+    {
+      Add,
+      Remove
+    };
+
+    std::vector<std::pair<EntityId, QueueOperation>> queue;
+
+  public:
+    ComponentPool(ComponentId componentId, ComponentMaskSet& componentMasks)
+      : ComponentPoolBase{componentId, componentMasks}
+    {
+    }
+
+    ~ComponentPool() override
+    {
+      if (listener)
+        delete listener;
+    }
+
+    void Emplace(EntityId entity, const Component&)
+    {
+      queue.emplace_back(entity, QueueOperation::Add);
+    }
+
+    bool Erase(EntityId entity) override
+    {
+      if (!componentMasks.Get(entity).test(componentId))
+        return false;
+
+      queue.emplace_back(entity, QueueOperation::Remove);
+      return true;
+    }
+
+    void CommitUpdates() override
+    {
+      for (auto& [entity, queueOperation] : queue)
+      {
+        switch (queueOperation)
+        {
+          case QueueOperation::Add:
+            CommitAddComponent(entity);
+            break;
+          case QueueOperation::Remove:
+            CommitRemoveComponent(entity);
+            break;
+        }
+      }
+      queue.clear();
+    }
+
+    Component& At(size_t index)
+    {
+      return operator[](index);
+    }
+
+    size_t Find(EntityId entity)
+    {
+      if (!componentMasks.Get(entity).test(componentId))
+        return Size();
+      return entities.Find(entity);
+    }
+
+    Component* FindComponent(EntityId entity)
+    {
+      if (!componentMasks.Get(entity).test(componentId))
+        return nullptr;
+      return &tag;
+    }
+
+    void SetComponentListener(ComponentListener<Component>* listener)
+    {
+      ComponentPool::listener = listener;
+    }
+
+    void Swap(size_t index1, size_t index2)
+    {
+      entities.Swap(index1, index2);
+    }
+
+    Component& operator[](size_t index)
+    {
+      CP_ASSERT(index < entities.Size(), "Index Out of Bound Exception");
+      return tag;
+    }
+
+    size_t Size() override
+    {
+      return entities.Size();
+    }
+
+  private:
+    void CommitAddComponent(EntityId entity)
+    {
+      // TODO: Same as for the non-empty ComponentPool, this assert doesn't say where the component was added
+      CP_ASSERT(!componentMasks.Get(entity).test(componentId),
+                "Component already exists in entity (entity=%u, Component=%s)",
+                entity,
+                typeid(Component).name());
+
+      componentMasks.Set(entity, componentId);
+      entities.Emplace(entity);
+      if (listener)
+        listener->Added(entity, tag);
+    }
+
+    void CommitRemoveComponent(EntityId entity)
+    {
+      if (!componentMasks.Get(entity).test(componentId))
+      {
+        CP_WARN("Entity did not contain component (entity=%u, Component=%s)", entity, typeid(Component).name());
+        return;
+      }
+
+      // Tags have no order to preserve, so there is no need to shift the remaining entities
+      componentMasks.Reset(entity, componentId);
+      entities.EraseUnordered(entity);
+      if (listener)
+        listener->Removed(entity, tag);
+    }
+  };
+
+  // Components with CP_COMPONENT_COLUMNS store each field in its own array, which are accessed with GetColumn.
+  // Since there is no Component stored in memory there is no reference access to these components
+  template <typename Component>
+  class ComponentPool<Component,
+                      std::enable_if_t<is_column_component_v<Component> && !std::is_empty_v<Component>>>
+    : public ComponentPoolBase
+  {
+    static_assert(std::is_trivially_copyable_v<Component>, "Column components must be trivially copyable");
+    static_assert(std::is_default_constructible_v<Component>, "Column components must be default constructible");
+
+    using Fields = typename ComponentColumns<Component>::Fields;
+
+  private:
+    typename Fields::Storage columns;
+    ComponentListener<Component>* listener = nullptr;
+
+    enum class QueueOperation
+    {
+      Add,
+      Remove
+    };
+
+    std::vector<QueueOperation> queueOperationOrder;
+    std::vector<std::pair<EntityId, Component>> addQueue;
+    std::vector<EntityId> removeQueue;
+
+  public:
+    ComponentPool(ComponentId componentId, ComponentMaskSet& componentMasks)
+      : ComponentPoolBase{componentId, componentMasks}
+    {
+    }
+
+    ~ComponentPool() override
+    {
+      if (listener)
+        delete listener;
+    }
+
+    void Emplace(EntityId entity, const Component& component)
+    {
+      addQueue.emplace_back(entity, component);
+      queueOperationOrder.emplace_back(QueueOperation::Add);
+    }
+
+    bool Erase(EntityId entity) override
+    {
+      if (entities.Find(entity) == entities.Size())
+        return false;
+
+      removeQueue.emplace_back(entity);
+      queueOperationOrder.emplace_back(QueueOperation::Remove);
+
+      return true;
+    }
+
+    void CommitUpdates() override
+    {
+      if (queueOperationOrder.empty())
+        return;
+
+      int addQueueIndex = 0;
+      int removeQueueIndex = 0;
+      for (QueueOperation queueOperation : queueOperationOrder)
+      {
+        switch (queueOperation)
+        {
+          case QueueOperation::Add:
+          {
+            CommitAddComponent(addQueueIndex);
+            addQueueIndex++;
+            break;
+          }
+          case QueueOperation::Remove:
+          {
+            CommitRemoveComponent(removeQueueIndex);
+            removeQueueIndex++;
+            break;
+          }
+        }
+      }
+      removeQueue.clear();
+      addQueue.clear();
+      queueOperationOrder.clear();
+    }
+
+    // The column is indexed the same way as GetEntities
+    template <auto Field>
+    Span<typename MemberPointerTraits<decltype(Field)>::member_type> GetColumn()
+    {
+      constexpr size_t index = Fields::template IndexOf<Field>();
+      static_assert(index < std::tuple_size_v<typename Fields::Storage>,
+                    "GetColumn : Field is not part of the CP_COMPONENT_COLUMNS of the component");
+      return std::get<index>(columns);
+    }
+
+    // Gathers a copy of the component from all the columns
+    Component Get(size_t index)
+    {
+      CP_ASSERT(index < Size(), "Index Out of Bound Exception");
+      return Gather(index, IndexSequence{});
+    }
+
+    void Set(size_t index, const Component& component)
+    {
+      CP_ASSERT(index < Size(), "Index Out of Bound Exception");
+      Scatter(index, component, IndexSequence{});
+    }
+
+    size_t Find(EntityId entity)
+    {
+      return entities.Find(entity);
+    }
+
+    void SetComponentListener(ComponentListener<Component>* listener)
+    {
+      ComponentPool::listener = listener;
+    }
+
+    template <typename Compare>
+    void Sort(Compare compare)
+    {
+      for (size_t i = 1; i < Size(); i++)
+      {
+        for (size_t j = i; j > 0 && compare(Get(j), Get(j - 1)); j--)
+        {
+          Swap(j, j - 1);
+        }
+      }
+    }
+
+    void Swap(size_t index1, size_t index2)
+    {
+      std::apply([&](auto&... column) { (std::swap(column[index1], column[index2]), ...); }, columns);
+      entities.Swap(index1, index2);
+    }
+
+    size_t Size() override
+    {
+      return entities.Size();
+    }
+
+  private:
+    using IndexSequence = std::make_index_sequence<std::tuple_size_v<typename Fields::Storage>>;
+
+    template <size_t... Indices>
+    Component Gather(size_t index, std::index_sequence<Indices...>)
+    {
+      Component component{};
+      ((component.*GetField<Indices>() = std::get<Indices>(columns)[index]), ...);
+      return component;
+    }
+
+    template <size_t... Indices>
+    void Scatter(size_t index, const Component& component, std::index_sequence<Indices...>)
+    {
+      ((std::get<Indices>(columns)[index] = component.*GetField<Indices>()), ...);
+    }
+
+    template <size_t... Indices>
+    void PushBack(const Component& component, std::index_sequence<Indices...>)
+    {
+      (std::get<Indices>(columns).push_back(component.*GetField<Indices>()), ...);
+    }
+
+    template <size_t Index, auto... FieldList>
+    static constexpr auto GetFieldFrom(ColumnFields<FieldList...>)
+    {
+      return std::get<Index>(std::make_tuple(FieldList...));
+    }
+
+    template <size_t Index>
+    static constexpr auto GetField()
+    {
+      return GetFieldFrom<Index>(Fields{});
+    }
+
+    void CommitAddComponent(int queueIndex)
+    {
+      const auto& [entity, component] = addQueue[queueIndex];
+      CP_ASSERT(Find(entity) == Size(),
+                "Component already exists in entity (entity=%u, Component=%s)",
+                entity,
+                typeid(Component).name());
+
+      PushBack(component, IndexSequence{});
+      entities.Emplace(entity);
+      componentMasks.Set(entity, componentId);
+      if (listener)
+      {
+        Component added = component;
+        listener->Added(entity, added);
+      }
+    }
+
+    void CommitRemoveComponent(int queueIndex)
+    {
+      const auto& entity = removeQueue[queueIndex];
+      size_t index = entities.Find(entity);
+      if (index == entities.Size())
+      {
+        CP_WARN("Entity did not contain component (entity=%u, Component=%s)", entity, typeid(Component).name());
+        return;
+      }
+
+      Component removed{};
+      if (listener)
+        removed = Get(index);
+
+      entities.Erase(entity);
+      componentMasks.Reset(entity, componentId);
+      std::apply([&](auto&... column) { (column.erase(column.begin() + index), ...); }, columns);
+
+      if (listener)
+        listener->Removed(entity, removed);
+    }
+  };
 }
@@ -2,6 +2,12 @@
 
 namespace Copium
 {
+  ComponentPoolBase::ComponentPoolBase(ComponentId componentId, ComponentMaskSet& componentMasks)
+    : componentId{componentId},
+      componentMasks{componentMasks}
+  {
+  }
+
   std::vector<EntityId>& ComponentPoolBase::GetEntities()
   {
     return entities.GetList();
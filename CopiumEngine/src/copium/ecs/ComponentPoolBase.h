@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "copium/ecs/ComponentMaskSet.h"
 #include "copium/ecs/Config.h"
 #include "copium/ecs/EntitySet.h"
 
@@ -11,8 +12,11 @@ namespace Copium
   {
   protected:
     EntitySet entities;
+    ComponentId componentId;
+    ComponentMaskSet& componentMasks;
 
   public:
+    ComponentPoolBase(ComponentId componentId, ComponentMaskSet& componentMasks);
     virtual ~ComponentPoolBase() = default;
 
     virtual size_t Size() = 0;
@@ -0,0 +1,15 @@
+#include "copium/ecs/ComponentTypes.h"
+
+namespace Copium
+{
+  ComponentId ComponentTypes::nextId = 0;
+
+  ComponentId ComponentTypes::NextId(const char* componentName)
+  {
+    CP_ASSERT(nextId < MAX_NUM_COMPONENTS,
+              "Too many component types, increase MAX_NUM_COMPONENTS=%u (Component=%s)",
+              MAX_NUM_COMPONENTS,
+              componentName);
+    return nextId++;
+  }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <typeinfo>
+
+#include "copium/ecs/Config.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Hands out a dense id per component type, used as the bit index in the entity component masks
+  class ComponentTypes
+  {
+    CP_STATIC_CLASS(ComponentTypes);
+
+  private:
+    static ComponentId nextId;
+
+  public:
+    template <typename Component>
+    static ComponentId GetId()
+    {
+      static const ComponentId id = NextId(typeid(Component).name());
+      return id;
+    }
+
+  private:
+    static ComponentId NextId(const char* componentName);
+  };
+}
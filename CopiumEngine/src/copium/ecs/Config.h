@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 
+#include <bitset>
 #include <limits>
 
 namespace Copium
@@ -9,4 +10,8 @@ namespace Copium
   using EntityId = uint32_t;
   const static uint32_t MAX_NUM_ENTITIES = std::numeric_limits<uint32_t>::max();
   const static uint32_t INVALID_ENTITY = 0;
+
+  using ComponentId = uint32_t;
+  const static uint32_t MAX_NUM_COMPONENTS = 256;
+  using ComponentMask = std::bitset<MAX_NUM_COMPONENTS>;
 }
@@ -12,9 +12,9 @@ namespace Copium
 
   ECSManager::~ECSManager()
   {
-    for (auto&& components : componentPools)
+    for (auto&& pool : componentPools)
     {
-      delete components.second;
+      delete pool;
     }
     componentPools.clear();
   }
@@ -23,7 +23,8 @@ namespace Copium
   {
     for (auto& componentPool : componentPools)
     {
-      componentPool.second->CommitUpdates();
+      if (componentPool)
+        componentPool->CommitUpdates();
     }
   }
 
@@ -48,6 +49,7 @@ namespace Copium
     {
       EntityId newId = *destroyedEntityIds.begin();
       destroyedEntityIds.erase(destroyedEntityIds.begin());
+      entities.emplace(newId);
       return newId;
     }
 
@@ -75,9 +77,13 @@ namespace Copium
     }
 
     entities.erase(it);
-    for (auto&& pool : componentPools)
+
+    // Only visit the pools which the entity has committed components in
+    const ComponentMask& mask = componentMasks.Get(entity);
+    for (ComponentId componentId = 0; componentId < componentPools.size(); componentId++)
     {
-      pool.second->Erase(entity);
+      if (mask.test(componentId))
+        componentPools[componentId]->Erase(entity);
     }
   }
 
@@ -86,6 +92,65 @@ namespace Copium
     return entities.find(entity) != entities.end();
   }
 
+  EntityBatch ECSManager::SerializeEntities(const std::vector<EntityId>& entities)
+  {
+    EntityBatch batch;
+    for (auto& streamableComponent : streamableComponents)
+      batch.AddComponentType(streamableComponent.nameHash, streamableComponent.size);
+    SerializeEntities(batch, entities);
+    return batch;
+  }
+
+  void ECSManager::SerializeEntities(EntityBatch& batch, const std::vector<EntityId>& entities)
+  {
+    for (EntityId entity : entities)
+    {
+      const ComponentMask& mask = componentMasks.Get(entity);
+      uint16_t componentCount = 0;
+      for (auto& streamableComponent : streamableComponents)
+      {
+        if (mask.test(streamableComponent.componentId))
+          componentCount++;
+      }
+
+      batch.AddEntity(componentCount);
+      for (uint16_t i = 0; i < streamableComponents.size(); i++)
+      {
+        if (mask.test(streamableComponents[i].componentId))
+          streamableComponents[i].serialize(*this, entity, batch, i);
+      }
+    }
+  }
+
+  bool ECSManager::SpliceEntityBatch(EntityBatch& batch, uint32_t maxEntities, std::vector<EntityId>& splicedEntities)
+  {
+    for (uint32_t i = 0; i < maxEntities && !batch.IsFullyRead(); i++)
+    {
+      EntityId entity = CreateEntity();
+      uint16_t componentCount = batch.ReadEntity();
+      for (uint16_t j = 0; j < componentCount; j++)
+      {
+        EntityBatch::ComponentData componentData = batch.ReadComponent();
+        auto it = streamableComponentIndices.find(componentData.nameHash);
+        if (it == streamableComponentIndices.end())
+        {
+          CP_WARN("Skipping unregistered streamable component (hash=%llu)",
+                  (unsigned long long)componentData.nameHash);
+          continue;
+        }
+
+        const StreamableComponent& streamableComponent = streamableComponents[it->second];
+        CP_ASSERT(streamableComponent.size == componentData.size,
+                  "Streamable component size mismatch (size=%u, expected=%u)",
+                  componentData.size,
+                  streamableComponent.size);
+        streamableComponent.add(*this, entity, componentData.data);
+      }
+      splicedEntities.emplace_back(entity);
+    }
+    return batch.IsFullyRead();
+  }
+
   void ECSManager::Each(std::function<void(EntityId)> function)
   {
     for (auto e : entities)
@@ -1,17 +1,23 @@
 #pragma once
 
+#include <cstring>
 #include <functional>
 #include <map>
 #include <set>
 #include <typeindex>
+#include <unordered_map>
 #include <unordered_set>
 
+#include "copium/ecs/ComponentMaskSet.h"
 #include "copium/ecs/ComponentPool.h"
+#include "copium/ecs/ComponentTypes.h"
 #include "copium/ecs/Config.h"
+#include "copium/ecs/EntityBatch.h"
 #include "copium/ecs/Signal.h"
 #include "copium/ecs/SystemPool.h"
 #include "copium/util/Common.h"
 #include "copium/util/GenericType.h"
+#include "copium/util/Hash.h"
 #include "copium/util/Uuid.h"
 
 namespace Copium
@@ -22,7 +28,8 @@ namespace Copium
 
   private:
     std::unordered_set<EntityId> entities;
-    std::map<std::type_index, ComponentPoolBase*> componentPools;
+    std::vector<ComponentPoolBase*> componentPools;  // Indexed by the ComponentId
+    ComponentMaskSet componentMasks;                 // Committed components of each entity
 
     std::map<Uuid, std::unique_ptr<SystemPool>> systemPools;
     EntityId currentEntityId = 1;
@@ -30,6 +37,17 @@ namespace Copium
 
     std::map<std::type_index, GenericType> globalDatas;
 
+    struct StreamableComponent
+    {
+      uint64_t nameHash;
+      uint32_t size;
+      ComponentId componentId;
+      void (*add)(ECSManager& manager, EntityId entity, const uint8_t* data);
+      void (*serialize)(ECSManager& manager, EntityId entity, EntityBatch& batch, uint16_t typeIndex);
+    };
+    std::vector<StreamableComponent> streamableComponents;
+    std::unordered_map<uint64_t, size_t> streamableComponentIndices;  // Maps the name hash to streamableComponents
+
   public:
     static std::vector<EntityId> emptyEntities;
 
@@ -87,16 +105,9 @@ namespace Copium
       auto pool = GetComponentPool<Component>();
       Listener* listener = new Listener{args...};
       listener->manager = this;
-      if (pool)
-      {
-        pool->SetComponentListener(listener);
-      }
-      else
-      {
-        ComponentPool<Component>* pool{new ComponentPool<Component>{}};
-        componentPools.emplace(GetComponentId<Component>(), pool);
-        pool->SetComponentListener(listener);
-      }
+      if (!pool)
+        pool = CreateComponentPool<Component>();
+      pool->SetComponentListener(listener);
     }
 
     template <typename... Components>
@@ -115,16 +126,9 @@ namespace Copium
     void AddComponent(EntityId entity, const Component& component)
     {
       auto pool = GetComponentPool<Component>();
-
-      if (pool)
-      {
-        pool->Emplace(entity, component);
-      }
-      else
-      {
-        ComponentPool<Component>* pool{new ComponentPool{entity, component}};
-        auto ret = componentPools.emplace(GetComponentId<Component>(), pool);
-      }
+      if (!pool)
+        pool = CreateComponentPool<Component>();
+      pool->Emplace(entity, component);
     }
 
     template <typename Component>
@@ -143,6 +147,7 @@ namespace Copium
     template <typename Component>
     Component& GetComponent(EntityId entity)
     {
+      ValidateReferenceAccess<Component>();
       auto pool = GetComponentPoolAssure<Component>();
       Component* component = pool->FindComponent(entity);
       CP_ASSERT(
@@ -153,27 +158,25 @@ namespace Copium
     template <typename Component>
     bool HasComponent(EntityId entity)
     {
-      auto pool = GetComponentPool<Component>();
-      if (pool)
-        return pool->Find(entity) != pool->Size();
-      return false;
+      return componentMasks.Get(entity).test(GetComponentId<Component>());
     }
 
     template <typename... Components>
     bool HasComponents(EntityId entity)
     {
-      return (HasComponent<Components>(entity) && ...);
+      return componentMasks.Contains(entity, GetComponentMask<Components...>());
     }
 
     template <typename... Components>
     bool HasAnyComponent(EntityId entity)
     {
-      return (HasComponent<Components>(entity) || ...);
+      return componentMasks.ContainsAny(entity, GetComponentMask<Components...>());
     }
 
     template <typename Component, typename... Components, typename Func>
     void Each(Func function)
     {
+      ValidateReferenceAccess<Component, Components...>();
       auto pool = GetComponentPool<Component>();
       if (pool)
       {
@@ -192,6 +195,7 @@ namespace Copium
     template <typename Component>
     void Each(std::function<void(EntityId, Component&)> function)
     {
+      ValidateReferenceAccess<Component>();
       auto pool = GetComponentPool<Component>();
       if (pool)
       {
@@ -207,6 +211,7 @@ namespace Copium
     template <typename Component, typename... Components, typename Func>
     EntityId Find(Func function)
     {
+      ValidateReferenceAccess<Component, Components...>();
       auto pool = GetComponentPool<Component>();
       if (pool)
       {
@@ -227,6 +232,7 @@ namespace Copium
     template <typename Component>
     EntityId Find(std::function<bool(EntityId, Component&)> function)
     {
+      ValidateReferenceAccess<Component>();
       auto pool = GetComponentPool<Component>();
       if (pool)
       {
@@ -248,10 +254,115 @@ namespace Copium
                                             { return true; });
     }
 
+    // Sorts the committed components, View and Each will iterate in the sorted order
+    template <typename Component, typename Compare>
+    void Sort(Compare compare)
+    {
+      static_assert(!std::is_empty_v<Component>, "Sort : Empty components cannot be compared, use SortAs instead");
+      auto pool = GetComponentPool<Component>();
+      if (pool)
+        pool->Sort(compare);
+    }
+
+    // Orders the entities in the Component pool after the order of the Other pool, entities which doesn't have the
+    // Other component are placed last
+    template <typename Component, typename Other>
+    void SortAs()
+    {
+      auto pool = GetComponentPool<Component>();
+      auto otherPool = GetComponentPool<Other>();
+      if (!pool || !otherPool)
+        return;
+
+      size_t index = 0;
+      for (EntityId entity : otherPool->GetEntities())
+      {
+        if (!HasComponent<Component>(entity))
+          continue;
+
+        size_t currentIndex = pool->Find(entity);
+        if (currentIndex != index)
+          pool->Swap(currentIndex, index);
+        index++;
+      }
+    }
+
+    // Returns a field column of a CP_COMPONENT_COLUMNS component, indexed the same way as the entities of its pool
+    //   for (size_t i = 0; i < x.size(); i++)
+    //     x[i] += vx[i] * dt;
+    template <auto Field>
+    Span<typename MemberPointerTraits<decltype(Field)>::member_type> GetColumn()
+    {
+      using Component = typename MemberPointerTraits<decltype(Field)>::class_type;
+      static_assert(is_column_component_v<Component>, "GetColumn : Component doesn't use CP_COMPONENT_COLUMNS");
+      auto pool = GetComponentPool<Component>();
+      if (!pool)
+        return {};
+      return pool->template GetColumn<Field>();
+    }
+
+    // The name is stored in the serialized EntityBatch, so it needs to be stable between builds
+    template <typename Component>
+    void RegisterStreamableComponent(const std::string& name)
+    {
+      static_assert(std::is_trivially_copyable_v<Component>, "Streamable components must be trivially copyable");
+      uint64_t nameHash = Hash::Fnv1a(name);
+      CP_ASSERT(streamableComponentIndices.find(nameHash) == streamableComponentIndices.end(),
+                "Streamable component already registered (name=%s)",
+                name.c_str());
+
+      StreamableComponent streamableComponent;
+      streamableComponent.nameHash = nameHash;
+      streamableComponent.size = std::is_empty_v<Component> ? 0 : sizeof(Component);
+      streamableComponent.componentId = GetComponentId<Component>();
+      streamableComponent.add = [](ECSManager& manager, EntityId entity, const uint8_t* data)
+      {
+        Component component{};
+        if constexpr (!std::is_empty_v<Component>)
+          std::memcpy(&component, data, sizeof(Component));
+        manager.AddComponent(entity, component);
+      };
+      streamableComponent.serialize = [](ECSManager& manager, EntityId entity, EntityBatch& batch, uint16_t typeIndex)
+      {
+        auto pool = manager.GetComponentPoolAssure<Component>();
+        if constexpr (std::is_empty_v<Component>)
+        {
+          batch.AddComponent(typeIndex, nullptr);
+        }
+        else if constexpr (is_column_component_v<Component>)
+        {
+          Component component = pool->Get(pool->Find(entity));
+          batch.AddComponent(typeIndex, &component);
+        }
+        else
+        {
+          batch.AddComponent(typeIndex, pool->FindComponent(entity));
+        }
+      };
+      streamableComponentIndices.emplace(nameHash, streamableComponents.size());
+      streamableComponents.emplace_back(streamableComponent);
+    }
+
+    // Serializes the committed streamable components of the given entities
+    EntityBatch SerializeEntities(const std::vector<EntityId>& entities);
+    // Appends the committed streamable components of the given entities to a batch created by SerializeEntities
+    void SerializeEntities(EntityBatch& batch, const std::vector<EntityId>& entities);
+
+    // Creates up to maxEntities of the remaining entities in the batch, their components are queued like AddComponent
+    // and are committed in the next CommitEntityUpdates. Returns true when the whole batch has been spliced
+    bool SpliceEntityBatch(EntityBatch& batch, uint32_t maxEntities, std::vector<EntityId>& splicedEntities);
+
     template <typename T>
-    std::type_index GetComponentId()
+    ComponentId GetComponentId()
+    {
+      return ComponentTypes::GetId<std::remove_const_t<T>>();
+    }
+
+    template <typename... Components>
+    const ComponentMask& GetComponentMask()
     {
-      return std::type_index(typeid(T));
+      static const ComponentMask mask = CreateComponentMask<Components...>();
+      return mask;
     }
 
     template <typename T, typename... Args>
@@ -289,19 +400,46 @@ namespace Copium
     template <typename Component>
     ComponentPool<std::remove_const_t<Component>>* GetComponentPool()
     {
-      auto it = componentPools.find(GetComponentId<Component>());
-      return it == componentPools.end() ? nullptr
-                                        : static_cast<ComponentPool<std::remove_const_t<Component>>*>(it->second);
+      ComponentId componentId = GetComponentId<Component>();
+      if (componentId >= componentPools.size())
+        return nullptr;
+      return static_cast<ComponentPool<std::remove_const_t<Component>>*>(componentPools[componentId]);
     }
 
     template <typename Component>
     ComponentPool<std::remove_const_t<Component>>* GetComponentPoolAssure()
     {
-      auto it = componentPools.find(GetComponentId<Component>());
-      CP_ASSERT(it != componentPools.end(),
-                "Component has not been added to an entity (Component=%s)",
-                typeid(Component).name());
-      return static_cast<ComponentPool<std::remove_const_t<Component>>*>(it->second);
+      auto pool = GetComponentPool<Component>();
+      CP_ASSERT(pool, "Component has not been added to an entity (Component=%s)", typeid(Component).name());
+      return pool;
+    }
+
+  private:
+    template <typename Component>
+    ComponentPool<std::remove_const_t<Component>>* CreateComponentPool()
+    {
+      ComponentId componentId = GetComponentId<Component>();
+      if (componentId >= componentPools.size())
+        componentPools.resize(componentId + 1, nullptr);
+
+      auto pool = new ComponentPool<std::remove_const_t<Component>>{componentId, componentMasks};
+      componentPools[componentId] = pool;
+      return pool;
+    }
+
+    template <typename... Components>
+    static constexpr void ValidateReferenceAccess()
+    {
+      static_assert(!(is_column_component_v<std::remove_const_t<Components>> || ...),
+                    "Components with CP_COMPONENT_COLUMNS cannot be accessed by reference, use GetColumn instead");
+    }
+
+    template <typename... Components>
+    ComponentMask CreateComponentMask()
+    {
+      ComponentMask mask;
+      (mask.set(GetComponentId<Components>()), ...);
+      return mask;
     }
   };
 }
@@ -0,0 +1,131 @@
+#include "copium/ecs/EntityBatch.h"
+
+#include <cstring>
+
+#include "copium/util/Common.h"
+#include "copium/util/FileSystem.h"
+
+namespace Copium
+{
+  EntityBatch::EntityBatch(const std::vector<char>& fileData)
+  {
+    size_t position = 0;
+    CP_ASSERT(Read<uint32_t>(fileData, position) == MAGIC, "Invalid entity batch header");
+    uint32_t version = Read<uint32_t>(fileData, position);
+    CP_ASSERT(version == VERSION, "Unsupported entity batch version=%u", version);
+
+    entityCount = Read<uint32_t>(fileData, position);
+    uint32_t componentTypeCount = Read<uint32_t>(fileData, position);
+    componentTypes.reserve(componentTypeCount);
+    for (uint32_t i = 0; i < componentTypeCount; i++)
+    {
+      uint64_t nameHash = Read<uint64_t>(fileData, position);
+      uint32_t size = Read<uint32_t>(fileData, position);
+      componentTypes.emplace_back(ComponentType{nameHash, size});
+    }
+    data.assign(fileData.begin() + position, fileData.end());
+  }
+
+  uint16_t EntityBatch::AddComponentType(uint64_t nameHash, uint32_t size)
+  {
+    CP_ASSERT(componentTypes.size() < std::numeric_limits<uint16_t>::max(), "Too many component types in batch");
+    componentTypes.emplace_back(ComponentType{nameHash, size});
+    return componentTypes.size() - 1;
+  }
+
+  void EntityBatch::AddEntity(uint16_t componentCount)
+  {
+    Append(data, componentCount);
+    entityCount++;
+  }
+
+  void EntityBatch::AddComponent(uint16_t typeIndex, const void* component)
+  {
+    CP_ASSERT(typeIndex < componentTypes.size(), "Invalid component type index=%u", typeIndex);
+    Append(data, typeIndex);
+    const uint8_t* bytes = (const uint8_t*)component;
+    data.insert(data.end(), bytes, bytes + componentTypes[typeIndex].size);
+  }
+
+  bool EntityBatch::IsFullyRead() const
+  {
+    return readEntityCount == entityCount;
+  }
+
+  uint16_t EntityBatch::ReadEntity()
+  {
+    CP_ASSERT(!IsFullyRead(), "All entities in batch has already been read");
+    CP_ASSERT(readPosition + sizeof(uint16_t) <= data.size(), "Entity batch is truncated");
+    uint16_t componentCount;
+    std::memcpy(&componentCount, data.data() + readPosition, sizeof(uint16_t));
+    readPosition += sizeof(uint16_t);
+    readEntityCount++;
+    return componentCount;
+  }
+
+  EntityBatch::ComponentData EntityBatch::ReadComponent()
+  {
+    CP_ASSERT(readPosition + sizeof(uint16_t) <= data.size(), "Entity batch is truncated");
+    uint16_t typeIndex;
+    std::memcpy(&typeIndex, data.data() + readPosition, sizeof(uint16_t));
+    readPosition += sizeof(uint16_t);
+
+    CP_ASSERT(typeIndex < componentTypes.size(), "Invalid component type index=%u", typeIndex);
+    const ComponentType& type = componentTypes[typeIndex];
+    CP_ASSERT(readPosition + type.size <= data.size(), "Entity batch is truncated");
+    ComponentData componentData{type.nameHash, type.size, data.data() + readPosition};
+    readPosition += type.size;
+    return componentData;
+  }
+
+  uint32_t EntityBatch::GetEntityCount() const
+  {
+    return entityCount;
+  }
+
+  bool EntityBatch::IsEmpty() const
+  {
+    return entityCount == 0;
+  }
+
+  void EntityBatch::Write(const std::string& filename) const
+  {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(16 + componentTypes.size() * 12 + data.size());
+    Append(buffer, MAGIC);
+    Append(buffer, VERSION);
+    Append(buffer, entityCount);
+    Append(buffer, (uint32_t)componentTypes.size());
+    for (auto& componentType : componentTypes)
+    {
+      Append(buffer, componentType.nameHash);
+      Append(buffer, componentType.size);
+    }
+    buffer.insert(buffer.end(), data.begin(), data.end());
+    FileSystem::WriteFile(filename, (const char*)buffer.data(), buffer.size());
+  }
+
+  EntityBatch EntityBatch::Load(const std::string& filename)
+  {
+    if (!FileSystem::FileExists(filename))
+      return EntityBatch{};
+    return EntityBatch{FileSystem::ReadFile(filename)};
+  }
+
+  template <typename T>
+  void EntityBatch::Append(std::vector<uint8_t>& buffer, const T& value) const
+  {
+    const uint8_t* bytes = (const uint8_t*)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  template <typename T>
+  T EntityBatch::Read(const std::vector<char>& buffer, size_t& position) const
+  {
+    CP_ASSERT(position + sizeof(T) <= buffer.size(), "Entity batch is truncated");
+    T value;
+    std::memcpy(&value, buffer.data() + position, sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
+}
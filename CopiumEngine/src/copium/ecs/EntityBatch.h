@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "copium/ecs/Config.h"
+
+namespace Copium
+{
+  // Serialized entities and their streamable components, see ECSManager::SerializeEntities
+  // The data contains one record per entity: uint16 componentCount, then (uint16 typeIndex, component bytes)
+  class EntityBatch
+  {
+  public:
+    struct ComponentType
+    {
+      uint64_t nameHash;
+      uint32_t size;
+    };
+
+    struct ComponentData
+    {
+      uint64_t nameHash;
+      uint32_t size;
+      const uint8_t* data;
+    };
+
+  private:
+    static constexpr uint32_t MAGIC = 0x43575043;  // "CPWC"
+    static constexpr uint32_t VERSION = 1;
+
+    std::vector<ComponentType> componentTypes;
+    std::vector<uint8_t> data;
+    uint32_t entityCount = 0;
+
+    size_t readPosition = 0;
+    uint32_t readEntityCount = 0;
+
+  public:
+    EntityBatch() = default;
+    EntityBatch(const std::vector<char>& fileData);
+
+    uint16_t AddComponentType(uint64_t nameHash, uint32_t size);
+    void AddEntity(uint16_t componentCount);
+    void AddComponent(uint16_t typeIndex, const void* component);
+
+    bool IsFullyRead() const;
+    uint16_t ReadEntity();
+    ComponentData ReadComponent();
+
+    uint32_t GetEntityCount() const;
+    bool IsEmpty() const;
+    void Write(const std::string& filename) const;
+
+    static EntityBatch Load(const std::string& filename);
+
+  private:
+    template <typename T>
+    void Append(std::vector<uint8_t>& buffer, const T& value) const;
+
+    template <typename T>
+    T Read(const std::vector<char>& buffer, size_t& position) const;
+  };
+}
@@ -33,6 +33,24 @@ namespace Copium
     return true;
   }
 
+  bool EntitySet::EraseUnordered(EntityId entity)
+  {
+    auto it = entitiesMap.find(entity);
+    if (it == entitiesMap.end())
+      return false;
+    size_t componentPos = it->second;
+    entitiesMap.erase(it);
+
+    // Move the last entity into the removed slot
+    if (componentPos != entitiesList.size() - 1)
+    {
+      entitiesList[componentPos] = entitiesList.back();
+      entitiesMap[entitiesList[componentPos]] = componentPos;
+    }
+    entitiesList.pop_back();
+    return true;
+  }
+
   bool EntitySet::Pop()
   {
     if (entitiesList.size() == 0)
@@ -42,6 +60,13 @@ namespace Copium
     return true;
   }
 
+  void EntitySet::Swap(size_t index1, size_t index2)
+  {
+    std::swap(entitiesList[index1], entitiesList[index2]);
+    entitiesMap[entitiesList[index1]] = index1;
+    entitiesMap[entitiesList[index2]] = index2;
+  }
+
   size_t EntitySet::Find(EntityId entity)
   {
     auto it = entitiesMap.find(entity);
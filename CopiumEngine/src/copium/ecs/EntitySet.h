@@ -15,7 +15,9 @@ namespace Copium
   public:
     bool Emplace(EntityId entity);
     bool Erase(EntityId entity);
+    bool EraseUnordered(EntityId entity);
     bool Pop();
+    void Swap(size_t index1, size_t index2);
     size_t Find(EntityId entity);
     size_t Size() const;
     std::vector<EntityId>& GetList();
@@ -8,6 +8,10 @@ namespace Copium
   template <typename Component, typename... Components>
   struct View
   {
+    static_assert(!(is_column_component_v<std::remove_const_t<Components>> || ... ||
+                    is_column_component_v<std::remove_const_t<Component>>),
+                  "Components with CP_COMPONENT_COLUMNS cannot be viewed by reference, use ECSManager::GetColumn instead");
+
     class Iterator
     {
     public:
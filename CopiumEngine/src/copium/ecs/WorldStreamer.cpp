@@ -0,0 +1,359 @@
+#include "copium/ecs/WorldStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Copium
+{
+  WorldStreamer::WorldStreamer(ECSManager& manager,
+                               const std::string& directory,
+                               float cellSize,
+                               int loadRadius,
+                               int unloadRadius,
+                               const PositionGetter& getPosition,
+                               uint32_t maxEntitiesPerUpdate)
+    : manager{manager},
+      directory{directory},
+      cellSize{cellSize},
+      loadRadius{loadRadius},
+      unloadRadius{unloadRadius},
+      getPosition{getPosition},
+      maxEntitiesPerUpdate{maxEntitiesPerUpdate}
+  {
+    CP_ASSERT(cellSize > 0.0f, "Cell size must be positive (cellSize=%f)", cellSize);
+    CP_ASSERT(unloadRadius > loadRadius,
+              "Unload radius must be larger than the load radius to avoid thrashing (loadRadius=%d, unloadRadius=%d)",
+              loadRadius,
+              unloadRadius);
+    thread = std::thread{&WorldStreamer::ThreadLoop, this};
+  }
+
+  WorldStreamer::~WorldStreamer()
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      running = false;
+    }
+    condition.notify_one();
+    thread.join();
+  }
+
+  void WorldStreamer::Update(float focusX, float focusY)
+  {
+    // The components spliced in the previous update have been committed by ECSManager::UpdateSystems since then
+    for (auto& [coord, cell] : cells)
+    {
+      if (cell.state == CellState::Spliced)
+        cell.state = CellState::Loaded;
+    }
+
+    CellCoord focus = GetCellCoord(focusX, focusY);
+    UnloadCells(focus);
+    SpliceLoadedBatches();
+    LoadCells(focus);
+    RecellEntities();
+  }
+
+  void WorldStreamer::SaveAll()
+  {
+    for (auto& [coord, cell] : cells)
+    {
+      if (cell.state == CellState::Loaded)
+      {
+        EntityBatch batch = manager.SerializeEntities(GetValidEntities(cell.entities, 0, cell.entities.size()));
+        QueueJob(Job{JobType::Save, coord, std::move(batch)});
+      }
+    }
+  }
+
+  void WorldStreamer::AddEntity(EntityId entity, float x, float y)
+  {
+    CellCoord coord = GetCellCoord(x, y);
+    auto it = cells.find(coord);
+    CP_ASSERT(it != cells.end() && (it->second.state == CellState::Loaded || it->second.state == CellState::Spliced),
+              "Entity added to a cell which isn't loaded (cell=%d,%d)",
+              coord.first,
+              coord.second);
+    CP_ASSERT(entityCells.emplace(entity, coord).second, "Entity already belongs to a cell (entity=%u)", entity);
+    it->second.entities.emplace_back(entity);
+  }
+
+  void WorldStreamer::RemoveEntity(EntityId entity)
+  {
+    auto it = entityCells.find(entity);
+    if (it == entityCells.end())
+      return;
+
+    std::vector<EntityId>& entities = cells.at(it->second).entities;
+    auto entityIt = std::find(entities.begin(), entities.end(), entity);
+    if (entityIt != entities.end())
+    {
+      *entityIt = entities.back();
+      entities.pop_back();
+    }
+    entityCells.erase(it);
+  }
+
+  WorldStreamer::CellCoord WorldStreamer::GetCellCoord(float x, float y) const
+  {
+    return {(int)std::floor(x / cellSize), (int)std::floor(y / cellSize)};
+  }
+
+  size_t WorldStreamer::GetResidentCellCount() const
+  {
+    return cells.size();
+  }
+
+  void WorldStreamer::LoadCell(const CellCoord& coord)
+  {
+    if (cells.find(coord) != cells.end())
+      return;
+
+    cells.emplace(coord, Cell{});
+    QueueJob(Job{JobType::Load, coord, EntityBatch{}});
+  }
+
+  void WorldStreamer::LoadCells(const CellCoord& focus)
+  {
+    for (int y = focus.second - loadRadius; y <= focus.second + loadRadius; y++)
+    {
+      for (int x = focus.first - loadRadius; x <= focus.first + loadRadius; x++)
+      {
+        LoadCell(CellCoord{x, y});
+      }
+    }
+  }
+
+  void WorldStreamer::SpliceLoadedBatches()
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      for (auto& [coord, batch] : loadedBatches)
+      {
+        auto it = cells.find(coord);
+        if (it == cells.end())
+          continue;
+        it->second.batch = std::move(batch);
+        it->second.state = CellState::Splicing;
+      }
+      loadedBatches.clear();
+    }
+
+    // Limit the amount of entities created each update to avoid frame hitches
+    uint32_t budget = maxEntitiesPerUpdate;
+    for (auto& [coord, cell] : cells)
+    {
+      if (cell.state != CellState::Splicing)
+        continue;
+
+      if (budget == 0)
+        break;
+
+      size_t splicedStart = cell.entities.size();
+      bool done = manager.SpliceEntityBatch(cell.batch, budget, cell.entities);
+      budget -= cell.entities.size() - splicedStart;
+      for (size_t i = splicedStart; i < cell.entities.size(); i++)
+        entityCells.emplace(cell.entities[i], coord);
+
+      if (done)
+      {
+        cell.batch = EntityBatch{};
+        cell.state = CellState::Spliced;
+      }
+    }
+  }
+
+  void WorldStreamer::UnloadCells(const CellCoord& focus)
+  {
+    // Limit the amount of entities serialized and destroyed each update to avoid frame hitches
+    uint32_t budget = maxEntitiesPerUpdate;
+    for (auto it = cells.begin(); it != cells.end() && budget > 0;)
+    {
+      const CellCoord& coord = it->first;
+      Cell& cell = it->second;
+      int distance = std::max(std::abs(coord.first - focus.first), std::abs(coord.second - focus.second));
+
+      // Cells which are still being loaded are unloaded once their components are committed. A cell which comes back
+      // into range while unloading is loaded again from the file it is written to
+      if (cell.state == CellState::Loaded && distance > unloadRadius)
+      {
+        cell.state = CellState::Unloading;
+        cell.batch = manager.SerializeEntities({});
+        cell.unloadedCount = 0;
+      }
+
+      if (cell.state != CellState::Unloading)
+      {
+        ++it;
+        continue;
+      }
+
+      size_t count = std::min<size_t>(budget, cell.entities.size() - cell.unloadedCount);
+      std::vector<EntityId> entities =
+        GetValidEntities(cell.entities, cell.unloadedCount, cell.unloadedCount + count);
+      manager.SerializeEntities(cell.batch, entities);
+      for (EntityId entity : entities)
+      {
+        manager.DestroyEntity(entity);
+      }
+      for (size_t i = cell.unloadedCount; i < cell.unloadedCount + count; i++)
+      {
+        entityCells.erase(cell.entities[i]);
+      }
+      cell.unloadedCount += count;
+      budget -= count;
+
+      if (cell.unloadedCount < cell.entities.size())
+      {
+        ++it;
+        continue;
+      }
+
+      QueueJob(Job{JobType::Save, coord, std::move(cell.batch)});
+      it = cells.erase(it);
+    }
+  }
+
+  void WorldStreamer::RecellEntities()
+  {
+    if (cells.empty())
+      return;
+
+    // Continue from the cell where the previous update ran out of budget
+    auto it = cells.lower_bound(recellCoord);
+    if (it == cells.end() || it->first != recellCoord)
+      recellIndex = 0;
+
+    uint32_t budget = maxEntitiesPerUpdate;
+    for (size_t visitedCells = 0; budget > 0 && visitedCells < cells.size(); visitedCells++)
+    {
+      if (it == cells.end())
+        it = cells.begin();
+
+      const CellCoord& coord = it->first;
+      Cell& cell = it->second;
+      // Only committed entities have positions, and only loaded cells can take in entities
+      while (cell.state == CellState::Loaded && recellIndex < cell.entities.size() && budget > 0)
+      {
+        budget--;
+        EntityId entity = cell.entities[recellIndex];
+        if (!manager.ValidEntity(entity))
+        {
+          // Destroyed outside of the streamer
+          entityCells.erase(entity);
+          cell.entities[recellIndex] = cell.entities.back();
+          cell.entities.pop_back();
+          continue;
+        }
+
+        float x;
+        float y;
+        if (!getPosition(entity, x, y) || GetCellCoord(x, y) == coord)
+        {
+          recellIndex++;
+          continue;
+        }
+
+        // The entity stays in its current cell until the new cell is loaded
+        CellCoord newCoord = GetCellCoord(x, y);
+        auto newIt = cells.find(newCoord);
+        if (newIt == cells.end() || newIt->second.state != CellState::Loaded)
+        {
+          LoadCell(newCoord);
+          recellIndex++;
+          continue;
+        }
+
+        newIt->second.entities.emplace_back(entity);
+        entityCells[entity] = newCoord;
+        cell.entities[recellIndex] = cell.entities.back();
+        cell.entities.pop_back();
+      }
+
+      if (cell.state == CellState::Loaded && recellIndex < cell.entities.size())
+        break;
+      ++it;
+      recellIndex = 0;
+    }
+
+    if (it == cells.end())
+      it = cells.begin();
+    recellCoord = it->first;
+  }
+
+  std::vector<EntityId> WorldStreamer::GetValidEntities(const std::vector<EntityId>& entities,
+                                                        size_t begin,
+                                                        size_t end)
+  {
+    // Skip entities which has been destroyed outside of the streamer
+    std::vector<EntityId> validEntities;
+    validEntities.reserve(end - begin);
+    for (size_t i = begin; i < end; i++)
+    {
+      if (manager.ValidEntity(entities[i]))
+        validEntities.emplace_back(entities[i]);
+    }
+    return validEntities;
+  }
+
+  void WorldStreamer::QueueJob(Job&& job)
+  {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      jobs.emplace_back(std::move(job));
+    }
+    condition.notify_one();
+  }
+
+  std::string WorldStreamer::GetCellFilename(const CellCoord& coord) const
+  {
+    return String::Format("%s/cell_%d_%d.bin", directory.c_str(), coord.first, coord.second);
+  }
+
+  void WorldStreamer::ThreadLoop()
+  {
+    while (true)
+    {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this] { return !running || !jobs.empty(); });
+
+        // Finish writing all the cells before exiting
+        if (jobs.empty())
+          return;
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+
+      // Jobs are handled in order, so a cell which is saved and then loaded again will read the saved file
+      try
+      {
+        switch (job.type)
+        {
+          case JobType::Load:
+          {
+            EntityBatch batch = EntityBatch::Load(GetCellFilename(job.coord));
+            std::lock_guard<std::mutex> lock{mutex};
+            loadedBatches.emplace_back(job.coord, std::move(batch));
+            break;
+          }
+          case JobType::Save:
+          {
+            job.batch.Write(GetCellFilename(job.coord));
+            break;
+          }
+        }
+      }
+      catch (const RuntimeException& exception)
+      {
+        CP_WARN("Failed to stream cell (cell=%d,%d): %s", job.coord.first, job.coord.second, exception.GetErrorMessage().c_str());
+        if (job.type == JobType::Load)
+        {
+          std::lock_guard<std::mutex> lock{mutex};
+          loadedBatches.emplace_back(job.coord, EntityBatch{});
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "copium/ecs/ECSManager.h"
+#include "copium/ecs/EntityBatch.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Streams the entities of a grid of cells in and out of an ECSManager around a focus point.
+  // Cells are stored as EntityBatch files, loading and writing them is done on a background thread. The component
+  // pools can only be accessed from the main thread, so splicing, serializing and destroying entities is instead
+  // spread over several updates. Cells are serialized from the committed components, so entities are only streamed
+  // out once a CommitEntityUpdates has passed since they were spliced, and are destroyed through DestroyEntity like
+  // in any system
+  class WorldStreamer
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(WorldStreamer);
+
+  public:
+    using CellCoord = std::pair<int, int>;
+    // Returns false if the entity has no position, which keeps it in its current cell
+    using PositionGetter = std::function<bool(EntityId entity, float& x, float& y)>;
+
+  private:
+    enum class CellState
+    {
+      Loading,
+      Splicing,
+      Spliced,  // Components of the spliced entities are not committed yet
+      Loaded,
+      Unloading
+    };
+
+    struct Cell
+    {
+      CellState state = CellState::Loading;
+      std::vector<EntityId> entities;
+      EntityBatch batch;
+      size_t unloadedCount = 0;
+    };
+
+    enum class JobType
+    {
+      Load,
+      Save
+    };
+
+    struct Job
+    {
+      JobType type;
+      CellCoord coord;
+      EntityBatch batch;
+    };
+
+    ECSManager& manager;
+    std::string directory;
+    float cellSize;
+    int loadRadius;
+    int unloadRadius;
+    PositionGetter getPosition;
+    uint32_t maxEntitiesPerUpdate;
+
+    std::map<CellCoord, Cell> cells;
+    std::unordered_map<EntityId, CellCoord> entityCells;
+    CellCoord recellCoord{};
+    size_t recellIndex = 0;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool running = true;
+    std::deque<Job> jobs;
+    std::vector<std::pair<CellCoord, EntityBatch>> loadedBatches;
+
+  public:
+    WorldStreamer(ECSManager& manager,
+                  const std::string& directory,
+                  float cellSize,
+                  int loadRadius,
+                  int unloadRadius,
+                  const PositionGetter& getPosition,
+                  uint32_t maxEntitiesPerUpdate = 2000);
+    ~WorldStreamer();
+
+    // Should be called once per frame before ECSManager::UpdateSystems. Splices, unloads and checks the cell of at
+    // most maxEntitiesPerUpdate entities each
+    void Update(float focusX, float focusY);
+
+    // Writes the committed components of all loaded cells to disk, e.g. before saving the game. Cells which are still
+    // being spliced are skipped, and cells which are being unloaded are written once they are done
+    void SaveAll();
+
+    // Makes the entity belong to the cell at the given position, so that it is streamed out with that cell
+    void AddEntity(EntityId entity, float x, float y);
+    void RemoveEntity(EntityId entity);
+
+    CellCoord GetCellCoord(float x, float y) const;
+    size_t GetResidentCellCount() const;
+
+  private:
+    void LoadCell(const CellCoord& coord);
+    void LoadCells(const CellCoord& focus);
+    void SpliceLoadedBatches();
+    void UnloadCells(const CellCoord& focus);
+    // Moves entities whose position has left their cell, a few cells at a time
+    void RecellEntities();
+    std::vector<EntityId> GetValidEntities(const std::vector<EntityId>& entities, size_t begin, size_t end);
+    void QueueJob(Job&& job);
+    std::string GetCellFilename(const CellCoord& coord) const;
+
+    void ThreadLoop();
+  };
+}
@@ -75,6 +75,10 @@ namespace Copium
 
   glm::vec2 Input::GetMouseWindowPos()
   {
+    // There is no window to move the mouse in
+    if (Vulkan::IsHeadless())
+      return glm::vec2{0.0f};
+
     return glm::vec2{(mousePos.x + 1.0f) * 0.5f * Vulkan::GetWindow().GetWidth(),
                      (1.0f - mousePos.y) * 0.5f * Vulkan::GetWindow().GetHeight()};
   }
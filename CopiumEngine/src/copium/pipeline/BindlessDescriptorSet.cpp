@@ -0,0 +1,138 @@
+#include "copium/pipeline/BindlessDescriptorSet.h"
+
+#include <algorithm>
+
+#include "copium/core/Vulkan.h"
+#include "copium/sampler/Sampler.h"
+
+namespace Copium
+{
+  BindlessDescriptorSet::BindlessDescriptorSet()
+  {
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties{};
+    descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+    VkPhysicalDeviceProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &descriptorIndexingProperties;
+    vkGetPhysicalDeviceProperties2(Vulkan::GetDevice().GetPhysicalDevice(), &properties);
+    capacity = std::min({MAX_NUM_TEXTURES,
+                         descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+                         descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                         descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                         descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers});
+    CP_INFO("Bindless texture capacity: %u", capacity);
+
+    InitializeDescriptorSetLayout();
+    InitializeDescriptorPool();
+    InitializeDescriptorSet();
+  }
+
+  BindlessDescriptorSet::~BindlessDescriptorSet()
+  {
+    // Destroying the pool frees the descriptor set
+    vkDestroyDescriptorPool(Vulkan::GetDevice(), descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(Vulkan::GetDevice(), descriptorSetLayout, nullptr);
+  }
+
+  int BindlessDescriptorSet::AddSampler(const Sampler& sampler)
+  {
+    int index;
+    if (!freeIndices.empty())
+    {
+      index = freeIndices.back();
+      freeIndices.pop_back();
+    }
+    else
+    {
+      CP_ASSERT(nextIndex < capacity, "Maximum number of bindless textures reached (%u)", capacity);
+      index = nextIndex++;
+    }
+
+    // The image info is the same for all flight indices for textures
+    VkDescriptorImageInfo imageInfo = sampler.GetDescriptorImageInfo(0);
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.dstArrayElement = index;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = nullptr;
+    descriptorWrite.pImageInfo = &imageInfo;
+    descriptorWrite.pTexelBufferView = nullptr;
+    vkUpdateDescriptorSets(Vulkan::GetDevice(), 1, &descriptorWrite, 0, nullptr);
+    return index;
+  }
+
+  void BindlessDescriptorSet::RemoveSampler(int index)
+  {
+    // The descriptor is left as is, it is partially bound and will be overwritten when the index is reused
+    freeIndices.emplace_back(index);
+  }
+
+  VkDescriptorSetLayout BindlessDescriptorSet::GetDescriptorSetLayout() const
+  {
+    return descriptorSetLayout;
+  }
+
+  BindlessDescriptorSet::operator VkDescriptorSet() const
+  {
+    return descriptorSet;
+  }
+
+  void BindlessDescriptorSet::InitializeDescriptorSetLayout()
+  {
+    VkDescriptorSetLayoutBinding layoutBinding{};
+    layoutBinding.binding = 0;
+    layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    layoutBinding.descriptorCount = capacity;
+    layoutBinding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+    layoutBinding.pImmutableSamplers = nullptr;
+
+    VkDescriptorBindingFlagsEXT bindingFlags =
+      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo{};
+    bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    bindingFlagsCreateInfo.bindingCount = 1;
+    bindingFlagsCreateInfo.pBindingFlags = &bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    createInfo.pNext = &bindingFlagsCreateInfo;
+    createInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    createInfo.bindingCount = 1;
+    createInfo.pBindings = &layoutBinding;
+
+    CP_VK_ASSERT(vkCreateDescriptorSetLayout(Vulkan::GetDevice(), &createInfo, nullptr, &descriptorSetLayout),
+                 "Failed to initialize bindless descriptor set layout");
+  }
+
+  void BindlessDescriptorSet::InitializeDescriptorPool()
+  {
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSize.descriptorCount = capacity;
+
+    VkDescriptorPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    createInfo.poolSizeCount = 1;
+    createInfo.pPoolSizes = &poolSize;
+    createInfo.maxSets = 1;
+
+    CP_VK_ASSERT(vkCreateDescriptorPool(Vulkan::GetDevice(), &createInfo, nullptr, &descriptorPool),
+                 "Failed to initialize bindless descriptor pool");
+  }
+
+  void BindlessDescriptorSet::InitializeDescriptorSet()
+  {
+    VkDescriptorSetAllocateInfo allocateInfo{};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = descriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &descriptorSetLayout;
+
+    CP_VK_ASSERT(vkAllocateDescriptorSets(Vulkan::GetDevice(), &allocateInfo, &descriptorSet),
+                 "Failed to allocate bindless descriptor set");
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  class Sampler;
+
+  // A single update-after-bind array of all loaded textures, requires Device::SupportsBindless.
+  // Shaders declare it as an unsized array, ie "layout(set = 0, binding = 0) uniform sampler2D textures[];", and index it
+  // with nonuniformEXT(texIndex). Pipelines bind it automatically to the set of that array
+  class BindlessDescriptorSet final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(BindlessDescriptorSet);
+
+  private:
+    static constexpr uint32_t MAX_NUM_TEXTURES = 4096;  // Upper bound, lowered to the update-after-bind device limits
+
+    uint32_t capacity;
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkDescriptorPool descriptorPool;
+    VkDescriptorSet descriptorSet;
+    std::vector<int> freeIndices;
+    int nextIndex = 0;
+
+  public:
+    BindlessDescriptorSet();
+    ~BindlessDescriptorSet();
+
+    // Returns the stable index of the sampler in the texture array
+    int AddSampler(const Sampler& sampler);
+    // Must not be called before the GPU is done with the sampler
+    void RemoveSampler(int index);
+
+    VkDescriptorSetLayout GetDescriptorSetLayout() const;
+    operator VkDescriptorSet() const;
+
+  private:
+    void InitializeDescriptorSetLayout();
+    void InitializeDescriptorPool();
+    void InitializeDescriptorSet();
+  };
+}
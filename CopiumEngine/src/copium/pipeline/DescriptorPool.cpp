@@ -4,7 +4,7 @@
 
 namespace Copium
 {
-  DescriptorPool::DescriptorPool(int uniformDescriptorSets, int imageDescriptorSets)
+  DescriptorPool::DescriptorPool(int uniformDescriptorSets, int imageDescriptorSets, int storageDescriptorSets)
   {
     std::vector<VkDescriptorPoolSize> poolSizes;
     if (uniformDescriptorSets != 0)
@@ -23,11 +23,20 @@ namespace Copium
       poolSizes.emplace_back(descriptorSetPoolSize);
     }
 
+    if (storageDescriptorSets != 0)
+    {
+      VkDescriptorPoolSize descriptorSetPoolSize;
+      descriptorSetPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+      descriptorSetPoolSize.descriptorCount = storageDescriptorSets;
+      poolSizes.emplace_back(descriptorSetPoolSize);
+    }
+
     VkDescriptorPoolCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     createInfo.poolSizeCount = poolSizes.size();
     createInfo.pPoolSizes = poolSizes.data();
-    createInfo.maxSets = uniformDescriptorSets + imageDescriptorSets;  // I have no actual idea if this is fine
+    // I have no actual idea if this is fine
+    createInfo.maxSets = uniformDescriptorSets + imageDescriptorSets + storageDescriptorSets;
     createInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
     CP_VK_ASSERT(vkCreateDescriptorPool(Vulkan::GetDevice(), &createInfo, nullptr, &descriptorPool),
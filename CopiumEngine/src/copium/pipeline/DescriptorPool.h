@@ -14,7 +14,7 @@ namespace Copium
     VkDescriptorPool descriptorPool;
 
   public:
-    DescriptorPool(int uniformDescriptorSets, int imageDescriptorSets);
+    DescriptorPool(int uniformDescriptorSets, int imageDescriptorSets, int storageDescriptorSets = 0);
     ~DescriptorPool();
 
     std::vector<VkDescriptorSet> AllocateDescriptorSets(VkDescriptorSetLayout descriptorSetLayout);
@@ -6,6 +6,7 @@
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
+#include "copium/buffer/StorageBuffer.h"
 #include "copium/buffer/UniformBuffer.h"
 #include "copium/pipeline/DescriptorPool.h"
 #include "copium/pipeline/ShaderBinding.h"
@@ -36,6 +37,7 @@ namespace Copium
     void SetSamplerDynamic(const Sampler& sampler, uint32_t binding, int arrayIndex = 0);
     void SetSamplers(const std::vector<const Sampler*>& sampler, uint32_t binding);
     void SetSamplersDynamic(const std::vector<const Sampler*>& samplers, uint32_t binding);
+    void SetStorageBuffer(const StorageBuffer& storageBuffer, uint32_t binding);
     UniformBuffer& GetUniformBuffer(const std::string& uniformBuffer);
     uint32_t GetSetIndex() const;
     VkDescriptorSet GetVkDescriptorSet(int flightIndex) const;
@@ -1,12 +1,17 @@
 #include "copium/pipeline/Pipeline.h"
 
+#include <algorithm>
+
 #include "copium/buffer/Framebuffer.h"
 #include "copium/core/Vulkan.h"
 #include "copium/mesh/Vertex.h"
 #include "copium/mesh/VertexPassthrough.h"
 #include "copium/pipeline/Shader.h"
+#include "copium/renderer/LineInstance.h"
 #include "copium/renderer/LineVertex.h"
+#include "copium/renderer/RendererInstance.h"
 #include "copium/renderer/RendererVertex.h"
+#include "copium/renderer/TextInstance.h"
 
 namespace Copium
 {
@@ -29,9 +34,22 @@ namespace Copium
     PipelineCreator creator{
       renderPass, metaFileClass.GetValue("vert-filepath"), metaFileClass.GetValue("frag-filepath")};
     std::string type = metaFileClass.GetValue("type");
+    if (type == "Renderer" || type == "LineRenderer")
+    {
+      vertexFormat =
+        metaFileClass.GetValue("vertex-format", "float") == "packed" ? VertexFormat::Packed : VertexFormat::Float;
+    }
+
     if (type == "Renderer")
     {
-      creator.SetVertexDescriptor(RendererVertex::GetDescriptor());
+      creator.SetVertexDescriptor(vertexFormat == VertexFormat::Packed ? RendererVertexPacked::GetDescriptor()
+                                                                       : RendererVertex::GetDescriptor());
+      creator.SetDepthTest(false);
+      creator.SetBlending(true);
+    }
+    else if (type == "InstancedRenderer")
+    {
+      creator.SetVertexDescriptor(RendererInstance::GetDescriptor());
       creator.SetDepthTest(false);
       creator.SetBlending(true);
     }
@@ -48,10 +66,26 @@ namespace Copium
     }
     else if (type == "LineRenderer")
     {
-      creator.SetVertexDescriptor(LineVertex::GetDescriptor());
+      creator.SetVertexDescriptor(vertexFormat == VertexFormat::Packed ? LineVertexPacked::GetDescriptor()
+                                                                       : LineVertex::GetDescriptor());
       creator.SetPrimitiveTopology(VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
       creator.SetDepthTest(metaFileClass.GetValue("depth-test", "false") == "true" ? true : false);
     }
+    else if (type == "TextRenderer")
+    {
+      creator.SetVertexDescriptor(TextInstance::GetDescriptor());
+      // The y-axis of ui text is flipped, which flips the winding of the quads
+      creator.SetCullMode(VK_CULL_MODE_NONE);
+      creator.SetDepthTest(false);
+      creator.SetBlending(true);
+    }
+    else if (type == "InstancedLineRenderer")
+    {
+      creator.SetVertexDescriptor(LineInstance::GetDescriptor());
+      // The winding of the expanded quads depends on the direction of the line
+      creator.SetCullMode(VK_CULL_MODE_NONE);
+      creator.SetDepthTest(metaFileClass.GetValue("depth-test", "false") == "true" ? true : false);
+    }
     InitializeDescriptorSetLayout(creator);
     InitializePipeline(creator);
   }
@@ -68,6 +102,8 @@ namespace Copium
     VkPipeline graphicsPipelineCpy = graphicsPipeline;
     VkPipelineLayout pipelineLayoutCpy = pipelineLayout;
     std::vector<VkDescriptorSetLayout> descriptorSetLayoutsCpy = descriptorSetLayouts;
+    if (bindlessSetIndex != -1)
+      descriptorSetLayoutsCpy.erase(descriptorSetLayoutsCpy.begin() + bindlessSetIndex);
     Vulkan::GetDevice().QueueIdleCommand(
       [graphicsPipelineCpy, pipelineLayoutCpy, descriptorSetLayoutsCpy]()
       {
@@ -106,6 +142,28 @@ namespace Copium
                             nullptr);
   }
 
+  void Pipeline::BindDescriptorSets(const CommandBuffer& commandBuffer, const DescriptorSet& descriptorSet)
+  {
+    CP_ASSERT(descriptorSet.GetSetIndex() < GetDescriptorSetCount(), "DescriptorSet index is out of bounds");
+    std::vector<VkDescriptorSet> descriptorSets =
+      boundDescriptorSetsPerFlightIndex[Vulkan::GetSwapChain().GetFlightIndex()];
+    descriptorSets[descriptorSet.GetSetIndex()] = descriptorSet;
+    vkCmdBindDescriptorSets(commandBuffer,
+                            VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            pipelineLayout,
+                            0,
+                            descriptorSets.size(),
+                            descriptorSets.data(),
+                            0,
+                            nullptr);
+  }
+
+  void Pipeline::PushConstants(const CommandBuffer& commandBuffer, const void* data, uint32_t size)
+  {
+    CP_ASSERT(size <= pushConstantRange.size, "Push constant data is larger than the push constant block");
+    vkCmdPushConstants(commandBuffer, pipelineLayout, pushConstantRange.stageFlags, 0, size, data);
+  }
+
   std::unique_ptr<DescriptorSet> Pipeline::CreateDescriptorSet(DescriptorPool& descriptorPool, int setIndex) const
   {
     std::set<ShaderBinding> bindings;
@@ -138,6 +196,21 @@ namespace Copium
     return boundDescriptorSetsPerFlightIndex.front().size();
   }
 
+  bool Pipeline::IsBindless() const
+  {
+    return bindlessSetIndex != -1;
+  }
+
+  bool Pipeline::HasPushConstants() const
+  {
+    return pushConstantRange.size != 0;
+  }
+
+  VertexFormat Pipeline::GetVertexFormat() const
+  {
+    return vertexFormat;
+  }
+
   void Pipeline::InitializeDescriptorSetLayout(const PipelineCreator& creator)
   {
     boundDescriptorSetsPerFlightIndex.resize(SwapChain::MAX_FRAMES_IN_FLIGHT);
@@ -149,6 +222,23 @@ namespace Copium
     int i = 0;
     for (auto&& bindings : creator.descriptorSetLayouts)
     {
+      if (std::any_of(bindings.second.begin(),
+                      bindings.second.end(),
+                      [](const auto& binding) { return binding.bindless; }))
+      {
+        CP_ASSERT(Vulkan::GetDevice().SupportsBindless(), "Bindless textures are not supported by the device");
+        CP_ASSERT(bindings.second.size() == 1 && bindings.second.front().binding == 0,
+                  "The bindless texture array must be the only binding in its set and have binding = 0");
+        CP_ASSERT(bindlessSetIndex == -1, "Only one bindless texture array is supported per pipeline");
+        bindlessSetIndex = i;
+        descriptorSetLayouts[i++] = Vulkan::GetBindlessDescriptorSet().GetDescriptorSetLayout();
+        for (auto&& boundDescriptorSets : boundDescriptorSetsPerFlightIndex)
+        {
+          boundDescriptorSets[bindlessSetIndex] = Vulkan::GetBindlessDescriptorSet();
+        }
+        continue;
+      }
+
       std::vector<VkDescriptorSetLayoutBinding> layoutBindings{bindings.second.size()};
       int j = 0;
       for (auto&& binding : bindings.second)
@@ -274,8 +364,9 @@ namespace Copium
     pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutCreateInfo.setLayoutCount = descriptorSetLayouts.size();
     pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
-    pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-    pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
+    pushConstantRange = creator.pushConstantRange;
+    pipelineLayoutCreateInfo.pushConstantRangeCount = pushConstantRange.size != 0 ? 1 : 0;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
 
     CP_VK_ASSERT(vkCreatePipelineLayout(Vulkan::GetDevice(), &pipelineLayoutCreateInfo, nullptr, &pipelineLayout),
                  "Failed to initialize pipeline layout");
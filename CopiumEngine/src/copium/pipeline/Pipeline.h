@@ -10,6 +10,10 @@
 #include "copium/pipeline/DescriptorSet.h"
 #include "copium/pipeline/PipelineCreator.h"
 #include "copium/util/Common.h"
+#include "copium/util/Enum.h"
+
+#define CP_VERTEX_FORMAT_ENUMS Float, Packed
+CP_ENUM_CREATOR(Copium, VertexFormat, CP_VERTEX_FORMAT_ENUMS);
 
 namespace Copium
 {
@@ -24,6 +28,9 @@ namespace Copium
     VkPipelineLayout pipelineLayout;
     VkPipeline graphicsPipeline;
     AssetRef<Framebuffer> framebuffer;
+    int bindlessSetIndex = -1;
+    VertexFormat vertexFormat = VertexFormat::Float;
+    VkPushConstantRange pushConstantRange{};
 
   public:
     Pipeline(const MetaFile& metaFile);
@@ -33,11 +40,21 @@ namespace Copium
     void SetDescriptorSet(const DescriptorSet& descriptorSet);
     void SetDescriptorSetDynamic(const DescriptorSet& descriptorSet);
     void BindDescriptorSets(const CommandBuffer& commandBuffer);
+    // Binds the descriptor sets with descriptorSet in place of the one at its set index, without changing the pipeline.
+    // This allows multiple threads to record with the same pipeline
+    void BindDescriptorSets(const CommandBuffer& commandBuffer, const DescriptorSet& descriptorSet);
+    // Pushes to the "layout(push_constant) uniform" block of the shaders
+    void PushConstants(const CommandBuffer& commandBuffer, const void* data, uint32_t size);
 
     std::unique_ptr<DescriptorSet> CreateDescriptorSet(DescriptorPool& descriptorPool, int setIndex) const;
     DescriptorSet CreateDescriptorSetRef(DescriptorPool& descriptorPool, int setIndex) const;
 
     int GetDescriptorSetCount() const;
+    // Whether the shaders index the bindless texture array, which is always bound by the pipeline
+    bool IsBindless() const;
+    bool HasPushConstants() const;
+    // Selected with "vertex-format = packed" for pipelines of type "Renderer" and "LineRenderer"
+    VertexFormat GetVertexFormat() const;
 
   private:
     void InitializeDescriptorSetLayout(const PipelineCreator& creator);
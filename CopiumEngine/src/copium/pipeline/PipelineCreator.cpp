@@ -1,5 +1,7 @@
 #include "copium/pipeline/PipelineCreator.h"
 
+#include <algorithm>
+
 #include "copium/util/Common.h"
 
 namespace Copium
@@ -52,7 +54,15 @@ namespace Copium
       descriptorSetLayouts[binding.set].emplace_back(DescriptorSetBinding{binding.binding,
                                                                           GetDescriptorType(binding.bindingType),
                                                                           binding.arraySize,
-                                                                          GetShaderStageFlags(binding.shaderType)});
+                                                                          GetShaderStageFlags(binding.shaderType),
+                                                                          binding.bindless});
+    }
+
+    // All stages share the same push constant block starting at offset 0
+    for (auto& pushConstant : shaderReflector.pushConstants)
+    {
+      pushConstantRange.stageFlags |= GetShaderStageFlags(pushConstant.shaderType);
+      pushConstantRange.size = std::max(pushConstantRange.size, pushConstant.GetUniformBufferSize());
     }
   }
 
@@ -64,6 +74,8 @@ namespace Copium
         return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
       case BindingType::UniformBuffer:
         return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+      case BindingType::StorageBuffer:
+        return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
       default:
         CP_ABORT("Unhandled switch case");
     }
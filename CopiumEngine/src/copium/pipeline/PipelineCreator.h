@@ -18,11 +18,13 @@ namespace Copium
       VkDescriptorType type;
       uint32_t count;
       VkShaderStageFlags flags;
+      bool bindless;
     };
     friend class Pipeline;
 
   private:
     std::map<uint32_t, std::vector<DescriptorSetBinding>> descriptorSetLayouts{};
+    VkPushConstantRange pushConstantRange{};  // Size is 0 if the shaders don't declare push constants
 
     std::string vertexShader;
     std::string fragmentShader;
@@ -6,7 +6,7 @@
 
 #include "copium/util/Enum.h"
 
-#define CP_BINDING_TYPE_ENUMS Sampler2D, UniformBuffer
+#define CP_BINDING_TYPE_ENUMS Sampler2D, UniformBuffer, StorageBuffer
 #define CP_SHADER_TYPE_ENUMS Vertex, Fragment
 #define CP_UNIFORM_TYPE_ENUMS Mat3, Mat4, Vec2, Vec3, Vec4, Float, Int
 
@@ -22,6 +22,7 @@ namespace Copium
     uint32_t set;
     uint32_t binding;
     uint32_t arraySize;
+    bool bindless = false;  // Unsized sampler array, which is bound to the BindlessDescriptorSet
     BindingType bindingType;
     ShaderType shaderType;
     std::vector<std::pair<UniformType, std::string>> uniforms;
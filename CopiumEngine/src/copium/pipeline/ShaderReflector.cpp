@@ -53,6 +53,11 @@ namespace Copium
     ParseWhitespace(str, index);
     index++;  // "("
     ParseWhitespace(str, index);
+    if (std::string_view(&str[index], sizeof("push_constant") - 1) == "push_constant")
+    {
+      ParsePushConstant(str, index, shaderType);
+      return;
+    }
     if (std::string_view(&str[index], sizeof("set") - 1) != "set")
     {
       ParseLine(str, index);
@@ -76,16 +81,29 @@ namespace Copium
     ParseWhitespace(str, index);
     shaderBinding.binding = std::strtol(&str[index], &end, 10);
     index = end - str.c_str();
+    // Skips memory layout qualifiers, such as std430
+    while (str[index] != ')' && index < str.size())
+      index++;
+    index++;  // ")"
     ParseWhitespace(str, index);
-    index++;  // ")
-    ParseWhitespace(str, index);
-    index += sizeof("uniform") - 1;
+    // Skips memory qualifiers, such as readonly
+    std::string_view storage = ParseWord(str, index);
+    while (!storage.empty() && storage != "uniform" && storage != "buffer")
+    {
+      ParseWhitespace(str, index);
+      storage = ParseWord(str, index);
+    }
     ParseWhitespace(str, index);
 
     std::string_view type = ParseWord(str, index);
     ParseWhitespace(str, index);
     if (str[index] == '{')
-      ParseUniformBuffer(str, index, shaderBinding);
+    {
+      if (storage == "buffer")
+        ParseBlock(str, index);
+      else
+        ParseUniformBuffer(str, index, shaderBinding);
+    }
     ParseWhitespace(str, index);
     std::string_view name = ParseWord(str, index);
     shaderBinding.name = name;
@@ -94,7 +112,16 @@ namespace Copium
     if (str[index] == '[')
     {
       index++;
-      shaderBinding.arraySize = std::strtol(&str[index], &end, 10);
+      ParseWhitespace(str, index);
+      if (str[index] == ']')
+      {
+        shaderBinding.arraySize = 0;
+        shaderBinding.bindless = true;
+      }
+      else
+      {
+        shaderBinding.arraySize = std::strtol(&str[index], &end, 10);
+      }
     }
     else
     {
@@ -102,13 +129,42 @@ namespace Copium
     }
 
     ParseLine(str, index);
-    if (type == "sampler2D")
+    if (storage == "buffer")
+      shaderBinding.bindingType = BindingType::StorageBuffer;
+    else if (type == "sampler2D")
       shaderBinding.bindingType = BindingType::Sampler2D;
     else
       shaderBinding.bindingType = BindingType::UniformBuffer;
+    CP_ASSERT(!shaderBinding.bindless || shaderBinding.bindingType == BindingType::Sampler2D,
+              "Unsized arrays are only supported for sampler2D, name=%s",
+              shaderBinding.name.c_str());
     CP_ASSERT(bindings.emplace(shaderBinding).second, "multiple layouts with the same binding");
   }
 
+  void ShaderReflector::ParsePushConstant(const std::string& str, int& index, ShaderType shaderType)
+  {
+    ShaderBinding shaderBinding;
+    shaderBinding.shaderType = shaderType;
+    shaderBinding.set = 0;
+    shaderBinding.binding = 0;
+    shaderBinding.arraySize = 1;
+    shaderBinding.bindingType = BindingType::UniformBuffer;
+    index += sizeof("push_constant") - 1;
+    ParseWhitespace(str, index);
+    index++;  // ")"
+    ParseWhitespace(str, index);
+    index += sizeof("uniform") - 1;
+    ParseWhitespace(str, index);
+    ParseWord(str, index);  // block name
+    ParseWhitespace(str, index);
+    CP_ASSERT(str[index] == '{', "Expected push constant block");
+    ParseUniformBuffer(str, index, shaderBinding);
+    ParseWhitespace(str, index);
+    shaderBinding.name = ParseWord(str, index);
+    ParseLine(str, index);
+    pushConstants.emplace_back(shaderBinding);
+  }
+
   std::string_view ShaderReflector::ParseWord(const std::string& str, int& index)
   {
     int start = index;
@@ -119,6 +175,21 @@ namespace Copium
     return std::string_view(&str[start], index - start);
   }
 
+  void ShaderReflector::ParseBlock(const std::string& str, int& index)
+  {
+    int depth = 0;
+    while (index < str.size())
+    {
+      if (str[index] == '{')
+        depth++;
+      else if (str[index] == '}' && --depth == 0)
+        break;
+      index++;
+    }
+    if (index < str.size())
+      index++;  // go past "}"
+  }
+
   void ShaderReflector::ParseUniformBuffer(const std::string& str, int& index, ShaderBinding& binding)
   {
     index++;
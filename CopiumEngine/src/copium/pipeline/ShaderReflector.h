@@ -2,6 +2,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "copium/pipeline/ShaderBinding.h"
 
@@ -11,6 +12,7 @@ namespace Copium
   {
   public:
     std::set<ShaderBinding> bindings;
+    std::vector<ShaderBinding> pushConstants;  // One per shader stage which declares the push constant block
 
   public:
     ShaderReflector(const std::string& vertexGlslFile, const std::string& fragmentGlslFile);
@@ -20,7 +22,10 @@ namespace Copium
     void ParseLine(const std::string& str, int& index);
     void ParseWhitespace(const std::string& str, int& index);
     void ParseLayout(const std::string& str, int& index, ShaderType type);
+    void ParsePushConstant(const std::string& str, int& index, ShaderType type);
     std::string_view ParseWord(const std::string& str, int& index);
     void ParseUniformBuffer(const std::string& str, int& index, ShaderBinding& binding);
+    // Skips a block and its nested blocks, the content of storage buffers is not reflected
+    void ParseBlock(const std::string& str, int& index);
   };
 }
@@ -5,13 +5,13 @@
 namespace Copium
 {
   void VertexDescriptor::AddAttribute(
-    uint32_t binding, uint32_t location, VkFormat format, uint32_t offset, uint32_t size)
+    uint32_t binding, uint32_t location, VkFormat format, uint32_t offset, uint32_t size, VkVertexInputRate inputRate)
   {
     CP_ASSERT(binding <= bindings.size(),
               "Attribute binding must less than or be equal to the amount of current bindings");
 
     if (binding == bindings.size())
-      AddLayout(binding, size);
+      AddLayout(binding, size, inputRate);
 
     VkVertexInputAttributeDescription description{};
     description.binding = binding;
@@ -41,12 +41,12 @@ namespace Copium
     return bindings;
   }
 
-  uint32_t VertexDescriptor::AddLayout(uint32_t binding, uint32_t size)
+  uint32_t VertexDescriptor::AddLayout(uint32_t binding, uint32_t size, VkVertexInputRate inputRate)
   {
     VkVertexInputBindingDescription description{};
     description.binding = binding;
     description.stride = size;
-    description.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    description.inputRate = inputRate;
     bindings.emplace_back(description);
     return description.binding;
   }
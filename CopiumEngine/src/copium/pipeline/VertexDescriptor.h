@@ -13,12 +13,18 @@ namespace Copium
     std::vector<VkVertexInputAttributeDescription> attributes;
 
   public:
-    void AddAttribute(uint32_t binding, uint32_t location, VkFormat format, uint32_t offset, uint32_t size);
+    // The inputRate is only used by the first attribute of each binding
+    void AddAttribute(uint32_t binding,
+                      uint32_t location,
+                      VkFormat format,
+                      uint32_t offset,
+                      uint32_t size,
+                      VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX);
     VkDeviceSize GetVertexSize() const;
     const std::vector<VkVertexInputAttributeDescription>& GetAttributes() const;
     const std::vector<VkVertexInputBindingDescription>& GetBindings() const;
 
   private:
-    uint32_t AddLayout(uint32_t binding, uint32_t size);
+    uint32_t AddLayout(uint32_t binding, uint32_t size, VkVertexInputRate inputRate);
   };
 }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "copium/asset/AssetRef.h"
-#include "copium/buffer/RendererVertexBuffer.h"
 #include "copium/pipeline/DescriptorSet.h"
 #include "copium/pipeline/Pipeline.h"
 #include "copium/sampler/Sampler.h"
@@ -13,13 +12,11 @@ namespace Copium
     CP_DELETE_COPY_AND_MOVE_CTOR(Batch);
 
   private:
-    RendererVertexBuffer vertexBuffer;
     DescriptorPool descriptorPool;
     std::unique_ptr<DescriptorSet> descriptorSet;
 
   public:
-    Batch(AssetRef<Pipeline>& pipeline, int vertexCount, const std::vector<const Sampler*> samplers);
-    RendererVertexBuffer& GetVertexBuffer();
+    Batch(AssetRef<Pipeline>& pipeline, const std::vector<const Sampler*> samplers);
     DescriptorSet& GetDescriptorSet();
   };
 }
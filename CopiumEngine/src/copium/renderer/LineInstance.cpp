@@ -0,0 +1,19 @@
+#include "copium/renderer/LineInstance.h"
+
+namespace Copium
+{
+  VertexDescriptor LineInstance::GetDescriptor()
+  {
+    VertexDescriptor descriptor{};
+    descriptor.AddAttribute(0,
+                            0,
+                            VK_FORMAT_R32G32B32_SFLOAT,
+                            offsetof(LineInstance, from),
+                            sizeof(LineInstance),
+                            VK_VERTEX_INPUT_RATE_INSTANCE);
+    descriptor.AddAttribute(0, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(LineInstance, to), sizeof(LineInstance));
+    descriptor.AddAttribute(0, 2, VK_FORMAT_R8G8B8A8_UNORM, offsetof(LineInstance, color), sizeof(LineInstance));
+    descriptor.AddAttribute(0, 3, VK_FORMAT_R32_SFLOAT, offsetof(LineInstance, width), sizeof(LineInstance));
+    return descriptor;
+  }
+}
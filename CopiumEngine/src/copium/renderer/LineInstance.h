@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "copium/pipeline/VertexDescriptor.h"
+
+namespace Copium
+{
+  // One line segment per instance for pipelines of type "InstancedLineRenderer".
+  // The vertex shader expands the segment to a quad of two triangles from gl_VertexIndex (0-5), the corners are in the
+  // order (0, -1), (0, 1), (1, 1), (0, -1), (1, 1), (1, -1) where x interpolates from -> to and y is the side of the
+  // line. The sides are offset by width / 2 pixels perpendicular to the projected segment
+  struct LineInstance
+  {
+    glm::vec3 from;
+    glm::vec3 to;
+    uint32_t color;  // RGBA8 unorm
+    float width;
+
+    static VertexDescriptor GetDescriptor();
+  };
+}
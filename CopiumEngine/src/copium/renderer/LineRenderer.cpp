@@ -1,48 +1,68 @@
 #include "copium/renderer/LineRenderer.h"
 
 #include "copium/core/Vulkan.h"
-#include "copium/pipeline/PipelineCreator.h"
+#include "copium/renderer/LineInstance.h"
 #include "copium/renderer/LineVertex.h"
 
 namespace Copium
 {
-  static constexpr int MAX_NUM_LINES = 30000;
-  static constexpr int MAX_NUM_VERTICES = 2 * MAX_NUM_LINES;
+  static constexpr int MAX_NUM_LINES_PER_BATCH = 30000;
 
-  LineRenderer::LineRenderer(const AssetRef<Pipeline>& pipeline)
-    : descriptorPool{pipeline.GetAsset().GetDescriptorSetCount() * SwapChain::MAX_FRAMES_IN_FLIGHT, 0},
-      ibo{MAX_NUM_VERTICES},
+  LineRenderer::LineRenderer(const AssetRef<Pipeline>& pipeline, LineRendererMode mode)
+    : mode{mode},
       pipeline{pipeline},
-      vertexBuffer{LineVertex::GetDescriptor(), MAX_NUM_VERTICES}
+      packed{mode == LineRendererMode::Lines && pipeline.GetAsset().GetVertexFormat() == VertexFormat::Packed}
   {
-    InitializeIndexBuffer();
   }
 
-  LineRenderer::~LineRenderer() = default;
-
-  void LineRenderer::Draw(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)
+  void LineRenderer::Draw(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float width)
   {
     AllocateLine();
+    if (mode == LineRendererMode::Instanced)
+    {
+      LineInstance* instance = (LineInstance*)mappedVertexBuffer;
+      instance->from = from;
+      instance->to = to;
+      instance->color = glm::packUnorm4x8(glm::vec4{color, 1.0f});
+      instance->width = width;
+      mappedVertexBuffer = instance + 1;
+      return;
+    }
     AddVertex(from, color);
     AddVertex(to, color);
   }
 
+  void LineRenderer::Polyline(Span<const glm::vec3> points, const glm::vec3& color, float width)
+  {
+    for (size_t i = 1; i < points.size(); i++)
+    {
+      Draw(points[i - 1], points[i], color, width);
+    }
+  }
+
   void LineRenderer::AddVertex(const glm::vec3& position, const glm::vec3& color)
   {
+    if (packed)
+    {
+      LineVertexPacked* vertex = (LineVertexPacked*)mappedVertexBuffer;
+      vertex->pos = position;
+      vertex->color = glm::packUnorm4x8(glm::vec4{color, 1.0f});
+      mappedVertexBuffer = vertex + 1;
+      return;
+    }
+
     LineVertex* vertex = (LineVertex*)mappedVertexBuffer;
     vertex->pos = position;
     vertex->color = color;
-    mappedVertexBuffer = (LineVertex*)mappedVertexBuffer + 1;
+    mappedVertexBuffer = vertex + 1;
   }
 
   void LineRenderer::Begin(CommandBuffer& commandBuffer)
   {
     Pipeline& pl = pipeline.GetAsset();
     pl.Bind(commandBuffer);
-    ibo.Bind(commandBuffer);
-    mappedVertexBuffer = (char*)vertexBuffer.Map() + vertexBuffer.GetPosition(Vulkan::GetSwapChain().GetFlightIndex());
-    lineCount = 0;
     currentCommandBuffer = &commandBuffer;
+    NextBatch();
   }
 
   void LineRenderer::End()
@@ -60,31 +80,46 @@ namespace Copium
     pipeline.GetAsset().SetDescriptorSet(descriptorSet);
   }
 
-  void LineRenderer::InitializeIndexBuffer()
+  void LineRenderer::AllocateLine()
   {
-    CP_ASSERT(MAX_NUM_VERTICES < std::numeric_limits<uint16_t>::max(), "Maximum number of indices too big");
-
-    std::vector<uint16_t> indices;
-    indices.resize(MAX_NUM_VERTICES);
-    for (int i = 0; i < MAX_NUM_VERTICES; i++)
+    if (lineCount + 1 > batchLineCapacity)
     {
-      indices[i] = i;
+      Flush();
+      NextBatch();
     }
-    ibo.UpdateStaging(indices.data());
-  }
-
-  void LineRenderer::AllocateLine()
-  {
-    CP_ASSERT(lineCount + 1 <= MAX_NUM_LINES, "Max number of lines reached in LineRenderer");
     lineCount++;
   }
 
   void LineRenderer::Flush()
   {
-    vertexBuffer.Unmap();
-    vertexBuffer.Bind(*currentCommandBuffer);
+    Vulkan::GetTransientVertexBuffer().Commit(vertexAllocation, lineCount * GetLineSize());
+    if (lineCount == 0)
+      return;
+
+    TransientVertexBuffer::Bind(*currentCommandBuffer, vertexAllocation);
     Pipeline& pl = pipeline.GetAsset();
     pl.BindDescriptorSets(*currentCommandBuffer);
-    ibo.Draw(*currentCommandBuffer, lineCount * 2);
+    if (mode == LineRendererMode::Instanced)
+      vkCmdDraw(*currentCommandBuffer, 6, lineCount, 0, 0);
+    else
+      vkCmdDraw(*currentCommandBuffer, lineCount * 2, 1, 0, 0);
+  }
+
+  void LineRenderer::NextBatch()
+  {
+    vertexAllocation =
+      Vulkan::GetTransientVertexBuffer().Reserve(GetLineSize(), MAX_NUM_LINES_PER_BATCH * GetLineSize());
+    mappedVertexBuffer = vertexAllocation.data;
+    batchLineCapacity = vertexAllocation.size / GetLineSize();
+    lineCount = 0;
+  }
+
+  int LineRenderer::GetLineSize() const
+  {
+    if (mode == LineRendererMode::Instanced)
+      return sizeof(LineInstance);
+    if (packed)
+      return 2 * sizeof(LineVertexPacked);
+    return 2 * sizeof(LineVertex);
   }
 }
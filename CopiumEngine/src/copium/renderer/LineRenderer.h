@@ -3,10 +3,14 @@
 #include <glm/glm.hpp>
 
 #include "copium/buffer/CommandBuffer.h"
-#include "copium/buffer/IndexBuffer.h"
-#include "copium/buffer/RendererVertexBuffer.h"
+#include "copium/buffer/TransientVertexBuffer.h"
 #include "copium/pipeline/Pipeline.h"
 #include "copium/util/Common.h"
+#include "copium/util/Enum.h"
+#include "copium/util/Span.h"
+
+#define CP_LINE_RENDERER_MODE_ENUMS Lines, Instanced
+CP_ENUM_CREATOR(Copium, LineRendererMode, CP_LINE_RENDERER_MODE_ENUMS);
 
 namespace Copium
 {
@@ -14,36 +18,43 @@ namespace Copium
   {
     CP_DELETE_COPY_AND_MOVE_CTOR(LineRenderer);
 
-  public:
-    LineRenderer(const AssetRef<Pipeline>& pipeline);
-    ~LineRenderer();
-
-    void Draw(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color = glm::vec3{1, 1, 1});
-
-    void Begin(CommandBuffer& commandBuffer);
-    void End();
-
-    Pipeline& GetGraphicsPipeline();
-    void SetDescriptorSet(const DescriptorSet& descriptorSet);
-
   private:
-    DescriptorPool descriptorPool;
-    IndexBuffer ibo;
+    LineRendererMode mode;
     AssetRef<Pipeline> pipeline;
-
-    RendererVertexBuffer vertexBuffer;
+    bool packed;
 
     // Temporary data during a render
     CommandBuffer* currentCommandBuffer;
     int lineCount;
+    int batchLineCapacity;
+    TransientVertexBuffer::Allocation vertexAllocation;
     void* mappedVertexBuffer;
 
-  private:
-    void InitializeIndexBuffer();
+  public:
+    // Instanced mode requires a pipeline of type "InstancedLineRenderer" and draws the lines as quads of the given
+    // width in pixels, in lines mode the lines are always one pixel wide.
+    // The number of lines is unbounded, the lines are split into multiple draws when the vertex memory is full
+    LineRenderer(const AssetRef<Pipeline>& pipeline, LineRendererMode mode = LineRendererMode::Lines);
+
+    void Draw(const glm::vec3& from,
+              const glm::vec3& to,
+              const glm::vec3& color = glm::vec3{1, 1, 1},
+              float width = 1.0f);
+    // Draws lines between each consecutive pair of points
+    void Polyline(Span<const glm::vec3> points, const glm::vec3& color = glm::vec3{1, 1, 1}, float width = 1.0f);
+
+    void Begin(CommandBuffer& commandBuffer);
+    void End();
 
+    Pipeline& GetGraphicsPipeline();
+    void SetDescriptorSet(const DescriptorSet& descriptorSet);
+
+  private:
     void AllocateLine();
     void Flush();
+    void NextBatch();
 
     void AddVertex(const glm::vec3& position, const glm::vec3& color);
+    int GetLineSize() const;
   };
 }
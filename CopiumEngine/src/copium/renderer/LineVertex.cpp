@@ -9,4 +9,14 @@ namespace Copium
     descriptor.AddAttribute(0, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(LineVertex, color), sizeof(LineVertex));
     return descriptor;
   }
+
+  VertexDescriptor LineVertexPacked::GetDescriptor()
+  {
+    VertexDescriptor descriptor{};
+    descriptor.AddAttribute(
+      0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(LineVertexPacked, pos), sizeof(LineVertexPacked));
+    descriptor.AddAttribute(
+      0, 1, VK_FORMAT_R8G8B8A8_UNORM, offsetof(LineVertexPacked, color), sizeof(LineVertexPacked));
+    return descriptor;
+  }
 }
\ No newline at end of file
@@ -13,4 +13,13 @@ namespace Copium
 
     static VertexDescriptor GetDescriptor();
   };
+
+  // LineVertex with the color as RGBA8 unorm, 16 bytes instead of 24
+  struct LineVertexPacked
+  {
+    glm::vec3 pos;
+    uint32_t color;
+
+    static VertexDescriptor GetDescriptor();
+  };
 }
@@ -0,0 +1,217 @@
+#include "copium/renderer/ParticleEmitter.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define CP_PARTICLE_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CP_PARTICLE_NEON
+#endif
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+namespace Copium
+{
+  ParticleEmitter::ParticleEmitter(int capacity, const ParticleSettings& settings)
+    : capacity{capacity},
+      settings{settings}
+  {
+    CP_ASSERT(capacity > 0, "Particle capacity must be positive");
+
+    int paddedCapacity = (capacity + 3) & ~3;
+    for (std::vector<float>* attribute : {&positionX,
+                                          &positionY,
+                                          &velocityX,
+                                          &velocityY,
+                                          &age,
+                                          &invLifetime,
+                                          &colorR,
+                                          &colorG,
+                                          &colorB,
+                                          &size})
+    {
+      attribute->resize(paddedCapacity);
+    }
+  }
+
+  bool ParticleEmitter::Emit(const glm::vec2& position, const glm::vec2& velocity, float lifetime)
+  {
+    CP_ASSERT(lifetime > 0.0f, "Particle lifetime must be positive");
+    if (count == capacity)
+      return false;
+
+    positionX[count] = position.x;
+    positionY[count] = position.y;
+    velocityX[count] = velocity.x;
+    velocityY[count] = velocity.y;
+    age[count] = 0.0f;
+    invLifetime[count] = 1.0f / lifetime;
+    colorR[count] = settings.startColor.r;
+    colorG[count] = settings.startColor.g;
+    colorB[count] = settings.startColor.b;
+    size[count] = settings.startSize;
+    count++;
+    return true;
+  }
+
+  void ParticleEmitter::Update(float timeStep)
+  {
+    Integrate(timeStep);
+    RemoveDead();
+  }
+
+  void ParticleEmitter::Clear()
+  {
+    count = 0;
+  }
+
+  void ParticleEmitter::UpdateParallel(Span<ParticleEmitter* const> emitters, float timeStep)
+  {
+    int threadCount = std::min((int)std::max(std::thread::hardware_concurrency(), 1u), (int)emitters.size());
+    if (threadCount <= 1)
+    {
+      for (ParticleEmitter* emitter : emitters)
+        emitter->Update(timeStep);
+      return;
+    }
+
+    // Emitters are interleaved between the threads, which evens out the work when the emitter sizes are sorted
+    std::vector<std::future<void>> futures;
+    for (int i = 1; i < threadCount; i++)
+    {
+      futures.emplace_back(std::async(std::launch::async, [emitters, timeStep, threadCount, i]() {
+        for (size_t j = i; j < emitters.size(); j += threadCount)
+          emitters.data()[j]->Update(timeStep);
+      }));
+    }
+    for (size_t j = 0; j < emitters.size(); j += threadCount)
+      emitters.data()[j]->Update(timeStep);
+    for (std::future<void>& future : futures)
+      future.get();
+  }
+
+  int ParticleEmitter::GetCount() const
+  {
+    return count;
+  }
+
+  int ParticleEmitter::GetCapacity() const
+  {
+    return capacity;
+  }
+
+  const ParticleSettings& ParticleEmitter::GetSettings() const
+  {
+    return settings;
+  }
+
+  void ParticleEmitter::SetSettings(const ParticleSettings& settings)
+  {
+    this->settings = settings;
+  }
+
+  void ParticleEmitter::Integrate(float timeStep)
+  {
+    glm::vec2 deltaVelocity = settings.acceleration * timeStep;
+    glm::vec3 deltaColor = settings.endColor - settings.startColor;
+    float deltaSize = settings.endSize - settings.startSize;
+
+    int i = 0;
+#if defined(CP_PARTICLE_SSE)
+    __m128 dt = _mm_set1_ps(timeStep);
+    __m128 dvx = _mm_set1_ps(deltaVelocity.x);
+    __m128 dvy = _mm_set1_ps(deltaVelocity.y);
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 r0 = _mm_set1_ps(settings.startColor.r);
+    __m128 g0 = _mm_set1_ps(settings.startColor.g);
+    __m128 b0 = _mm_set1_ps(settings.startColor.b);
+    __m128 s0 = _mm_set1_ps(settings.startSize);
+    __m128 dr = _mm_set1_ps(deltaColor.r);
+    __m128 dg = _mm_set1_ps(deltaColor.g);
+    __m128 db = _mm_set1_ps(deltaColor.b);
+    __m128 ds = _mm_set1_ps(deltaSize);
+    for (; i < count; i += 4)
+    {
+      __m128 vx = _mm_add_ps(_mm_loadu_ps(&velocityX[i]), dvx);
+      __m128 vy = _mm_add_ps(_mm_loadu_ps(&velocityY[i]), dvy);
+      _mm_storeu_ps(&velocityX[i], vx);
+      _mm_storeu_ps(&velocityY[i], vy);
+      _mm_storeu_ps(&positionX[i], _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(vx, dt)));
+      _mm_storeu_ps(&positionY[i], _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(vy, dt)));
+
+      __m128 a = _mm_add_ps(_mm_loadu_ps(&age[i]), dt);
+      _mm_storeu_ps(&age[i], a);
+      __m128 t = _mm_min_ps(_mm_mul_ps(a, _mm_loadu_ps(&invLifetime[i])), one);
+      _mm_storeu_ps(&colorR[i], _mm_add_ps(r0, _mm_mul_ps(dr, t)));
+      _mm_storeu_ps(&colorG[i], _mm_add_ps(g0, _mm_mul_ps(dg, t)));
+      _mm_storeu_ps(&colorB[i], _mm_add_ps(b0, _mm_mul_ps(db, t)));
+      _mm_storeu_ps(&size[i], _mm_add_ps(s0, _mm_mul_ps(ds, t)));
+    }
+#elif defined(CP_PARTICLE_NEON)
+    float32x4_t dvx = vdupq_n_f32(deltaVelocity.x);
+    float32x4_t dvy = vdupq_n_f32(deltaVelocity.y);
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t r0 = vdupq_n_f32(settings.startColor.r);
+    float32x4_t g0 = vdupq_n_f32(settings.startColor.g);
+    float32x4_t b0 = vdupq_n_f32(settings.startColor.b);
+    float32x4_t s0 = vdupq_n_f32(settings.startSize);
+    for (; i < count; i += 4)
+    {
+      float32x4_t vx = vaddq_f32(vld1q_f32(&velocityX[i]), dvx);
+      float32x4_t vy = vaddq_f32(vld1q_f32(&velocityY[i]), dvy);
+      vst1q_f32(&velocityX[i], vx);
+      vst1q_f32(&velocityY[i], vy);
+      vst1q_f32(&positionX[i], vmlaq_n_f32(vld1q_f32(&positionX[i]), vx, timeStep));
+      vst1q_f32(&positionY[i], vmlaq_n_f32(vld1q_f32(&positionY[i]), vy, timeStep));
+
+      float32x4_t a = vaddq_f32(vld1q_f32(&age[i]), vdupq_n_f32(timeStep));
+      vst1q_f32(&age[i], a);
+      float32x4_t t = vminq_f32(vmulq_f32(a, vld1q_f32(&invLifetime[i])), one);
+      vst1q_f32(&colorR[i], vmlaq_n_f32(r0, t, deltaColor.r));
+      vst1q_f32(&colorG[i], vmlaq_n_f32(g0, t, deltaColor.g));
+      vst1q_f32(&colorB[i], vmlaq_n_f32(b0, t, deltaColor.b));
+      vst1q_f32(&size[i], vmlaq_n_f32(s0, t, deltaSize));
+    }
+#endif
+    for (; i < count; i++)
+    {
+      velocityX[i] += deltaVelocity.x;
+      velocityY[i] += deltaVelocity.y;
+      positionX[i] += velocityX[i] * timeStep;
+      positionY[i] += velocityY[i] * timeStep;
+      age[i] += timeStep;
+      float t = std::min(age[i] * invLifetime[i], 1.0f);
+      colorR[i] = settings.startColor.r + deltaColor.r * t;
+      colorG[i] = settings.startColor.g + deltaColor.g * t;
+      colorB[i] = settings.startColor.b + deltaColor.b * t;
+      size[i] = settings.startSize + deltaSize * t;
+    }
+  }
+
+  void ParticleEmitter::RemoveDead()
+  {
+    int i = 0;
+    while (i < count)
+    {
+      if (age[i] * invLifetime[i] < 1.0f)
+      {
+        i++;
+        continue;
+      }
+
+      count--;
+      positionX[i] = positionX[count];
+      positionY[i] = positionY[count];
+      velocityX[i] = velocityX[count];
+      velocityY[i] = velocityY[count];
+      age[i] = age[count];
+      invLifetime[i] = invLifetime[count];
+      colorR[i] = colorR[count];
+      colorG[i] = colorG[count];
+      colorB[i] = colorB[count];
+      size[i] = size[count];
+    }
+  }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "copium/util/Common.h"
+#include "copium/util/Span.h"
+
+namespace Copium
+{
+  struct ParticleSettings
+  {
+    glm::vec2 acceleration{0, 0};
+    glm::vec3 startColor{1, 1, 1};
+    glm::vec3 endColor{1, 1, 1};
+    float startSize = 1.0f;
+    float endSize = 1.0f;
+  };
+
+  // Fixed capacity particle storage with one array per attribute, so the update kernels can work on four particles at a
+  // time. Dead particles are replaced by the last live particle, so the particle order is not kept.
+  // Drawn with Renderer::Particles
+  class ParticleEmitter final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(ParticleEmitter);
+    friend class Renderer;
+
+  private:
+    int capacity;
+    int count = 0;
+    ParticleSettings settings;
+
+    // Padded to a multiple of four, the padding is updated but never drawn
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> age;
+    std::vector<float> invLifetime;
+    std::vector<float> colorR;
+    std::vector<float> colorG;
+    std::vector<float> colorB;
+    std::vector<float> size;
+
+  public:
+    ParticleEmitter(int capacity, const ParticleSettings& settings = ParticleSettings{});
+
+    // Returns false if the emitter is full
+    bool Emit(const glm::vec2& position, const glm::vec2& velocity, float lifetime);
+    // Integrates, ages and interpolates color and size over the lifetime of the particles, then removes dead particles
+    void Update(float timeStep);
+    void Clear();
+
+    // Updates the emitters on multiple threads, each emitter is only updated by one thread
+    static void UpdateParallel(Span<ParticleEmitter* const> emitters, float timeStep);
+
+    int GetCount() const;
+    int GetCapacity() const;
+    const ParticleSettings& GetSettings() const;
+    void SetSettings(const ParticleSettings& settings);
+
+  private:
+    void Integrate(float timeStep);
+    void RemoveDead();
+  };
+}
@@ -0,0 +1,73 @@
+#include "copium/renderer/RenderExtraction.h"
+
+#include <future>
+#include <thread>
+
+#include "copium/renderer/RenderQueue.h"
+
+namespace Copium
+{
+  RenderExtraction::RenderExtraction() = default;
+
+  void RenderExtraction::Publish()
+  {
+    items.clear();
+    items.reserve(packets.size());
+    for (uint32_t i = 0; i < packets.size(); i++)
+      items.emplace_back(Item{packets[i].key, i});
+    // The index breaks ties, which keeps the extraction order of equal keys
+    std::sort(items.begin(),
+              items.end(),
+              [](const Item& lhs, const Item& rhs)
+              { return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.index < rhs.index); });
+
+    int index = 1 - publishedIndex.load();
+    std::vector<SpriteInstance>& sprites = publishedSprites[index];
+    sprites.clear();
+    sprites.reserve(items.size());
+    for (const Item& item : items)
+      sprites.emplace_back(packets[item.index].sprite);
+    packets.clear();
+    publishedIndex.store(index);
+  }
+
+  Span<const SpriteInstance> RenderExtraction::GetSprites() const
+  {
+    return publishedSprites[publishedIndex.load()];
+  }
+
+  void RenderExtraction::Submit(Renderer& renderer) const
+  {
+    renderer.Quads(GetSprites());
+  }
+
+  uint64_t RenderExtraction::GetSortKey(uint8_t layer, float depth)
+  {
+    return ((uint64_t)layer << 32) | RenderQueue::GetSortableDepth(depth);
+  }
+
+  void RenderExtraction::RunParallel(size_t taskCount, const std::function<void(size_t)>& task)
+  {
+    size_t threadCount = std::min((size_t)std::max(std::thread::hardware_concurrency(), 1u), taskCount);
+    if (threadCount <= 1)
+    {
+      for (size_t i = 0; i < taskCount; i++)
+        task(i);
+      return;
+    }
+
+    // Tasks are picked from a shared counter, which balances chunks with different amounts of packets
+    std::atomic<size_t> nextTask{0};
+    auto worker = [&]()
+    {
+      for (size_t i = nextTask++; i < taskCount; i = nextTask++)
+        task(i);
+    };
+    std::vector<std::future<void>> futures;
+    for (size_t i = 1; i < threadCount; i++)
+      futures.emplace_back(std::async(std::launch::async, worker));
+    worker();
+    for (std::future<void>& future : futures)
+      future.get();
+  }
+}
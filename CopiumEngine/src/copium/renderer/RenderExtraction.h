@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "copium/ecs/ECSManager.h"
+#include "copium/renderer/Renderer.h"
+#include "copium/util/Common.h"
+#include "copium/util/Span.h"
+
+namespace Copium
+{
+  struct RenderPacket
+  {
+    uint64_t key;  // Packets are drawn in increasing key order, equal keys keep the extraction order
+    SpriteInstance sprite;
+  };
+
+  // Converts renderable components into a flat list of sprites, so that recording a frame never touches the ECS.
+  // Extraction and sorting write one buffer while the other, published the previous frame, is drawn. The published
+  // buffer must not be used anymore when the next but one Publish is called, ie rendering may lag one frame behind
+  class RenderExtraction final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(RenderExtraction);
+
+  public:
+    static constexpr size_t ENTITIES_PER_CHUNK = 4096;
+
+  private:
+    struct Item
+    {
+      uint64_t key;
+      uint32_t index;
+    };
+
+    std::vector<RenderPacket> packets;
+    std::vector<std::vector<RenderPacket>> chunkPackets;
+    std::vector<Item> items;
+    std::array<std::vector<SpriteInstance>, 2> publishedSprites;
+    std::atomic<int> publishedIndex{0};
+
+  public:
+    RenderExtraction();
+
+    // Appends a packet for each entity with all of the components, extract fills the packet and returns false to skip
+    // the entity:
+    //   bool extract(EntityId entity, const Component& c, const Components&... cs, RenderPacket& packet)
+    // Chunks of entities are extracted in parallel, so extract must not modify the ECS or any other shared state
+    template <typename Component, typename... Components, typename Func>
+    void Extract(ECSManager& manager, Func extract)
+    {
+      auto pool = manager.GetComponentPool<Component>();
+      if (!pool)
+        return;
+
+      const std::vector<EntityId>& entities = pool->GetEntities();
+      size_t chunkCount = (entities.size() + ENTITIES_PER_CHUNK - 1) / ENTITIES_PER_CHUNK;
+      if (chunkPackets.size() < chunkCount)
+        chunkPackets.resize(chunkCount);
+
+      RunParallel(chunkCount,
+                  [&](size_t chunk)
+                  {
+                    std::vector<RenderPacket>& chunkOutput = chunkPackets[chunk];
+                    chunkOutput.clear();
+                    size_t end = std::min(entities.size(), (chunk + 1) * ENTITIES_PER_CHUNK);
+                    for (size_t i = chunk * ENTITIES_PER_CHUNK; i < end; i++)
+                    {
+                      EntityId entity = entities[i];
+                      if (!manager.HasComponents<Components...>(entity))
+                        continue;
+
+                      RenderPacket packet{};
+                      if (extract(entity,
+                                  std::as_const(pool->At(i)),
+                                  std::as_const(manager.GetComponent<Components>(entity))...,
+                                  packet))
+                        chunkOutput.emplace_back(packet);
+                    }
+                  });
+
+      // Chunks are appended in entity order, so the extraction order doesn't depend on the threads
+      for (size_t i = 0; i < chunkCount; i++)
+        packets.insert(packets.end(), chunkPackets[i].begin(), chunkPackets[i].end());
+    }
+
+    // Sorts the extracted packets into the published buffer and clears them for the next extraction
+    void Publish();
+    // The sprites of the last Publish in key order
+    Span<const SpriteInstance> GetSprites() const;
+    // Draws the sprites of the last Publish, the renderer must be between Begin and End
+    void Submit(Renderer& renderer) const;
+
+    // Key ordered by layer and then by depth, higher depth is drawn later
+    static uint64_t GetSortKey(uint8_t layer, float depth);
+
+  private:
+    // Runs task(0) to task(taskCount - 1) on all hardware threads and returns when all of them are done
+    static void RunParallel(size_t taskCount, const std::function<void(size_t)>& task);
+  };
+}
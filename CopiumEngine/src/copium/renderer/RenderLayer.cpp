@@ -0,0 +1,18 @@
+#include "copium/renderer/RenderLayer.h"
+
+namespace Copium
+{
+  RenderLayer::RenderLayer() = default;
+
+  RenderLayer::~RenderLayer() = default;
+
+  void RenderLayer::MarkDirty()
+  {
+    dirty = true;
+  }
+
+  bool RenderLayer::IsDirty() const
+  {
+    return dirty;
+  }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "copium/buffer/Buffer.h"
+#include "copium/renderer/Batch.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Quads and text recorded once by a Renderer into a device local vertex buffer, which can be drawn every frame
+  // without regenerating the vertices. The samplers used while recording must outlive the recording, or the layer has
+  // to be rerecorded. The same goes for text with non-ASCII glyphs when the font's glyph generation changes
+  class RenderLayer final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(RenderLayer);
+    friend class Renderer;
+
+  private:
+    struct LayerBatch
+    {
+      int quadOffset;
+      int quadCount;
+      std::unique_ptr<Batch> batch;  // nullptr if the pipeline is bindless
+    };
+
+    std::vector<LayerBatch> batches;
+    std::unique_ptr<Buffer> vertexBuffer;
+    std::vector<uint8_t> vertexData;  // Only used while recording
+    int quadSize = 0;
+    bool dirty = true;
+
+  public:
+    RenderLayer();
+    ~RenderLayer();
+
+    // The layer keeps its content until it is recorded again
+    void MarkDirty();
+    bool IsDirty() const;
+  };
+}
@@ -0,0 +1,114 @@
+#include "copium/renderer/RenderQueue.h"
+
+#include <cstring>
+
+namespace Copium
+{
+  static constexpr int LAYER_BITS = 8;
+  static constexpr int TEXTURE_BITS = 24;
+  static constexpr int DEPTH_BITS = 32;
+  static_assert(LAYER_BITS + TEXTURE_BITS + DEPTH_BITS == 64);
+  static_assert(RenderQueue::MAX_NUM_LAYERS == 1 << LAYER_BITS);
+
+  RenderQueue::RenderQueue()
+  {
+    layerSortings.fill(LayerSorting::Opaque);
+  }
+
+  void RenderQueue::SetLayerSorting(int layer, LayerSorting layerSorting)
+  {
+    CP_ASSERT(layer >= 0 && layer < MAX_NUM_LAYERS, "Layer is out of bounds: %d", layer);
+    layerSortings[layer] = layerSorting;
+  }
+
+  void RenderQueue::Quad(int layer, float depth, const glm::vec2& pos, const glm::vec2& size, const glm::vec3& color)
+  {
+    AddItem(layer, depth, nullptr);
+    quads.emplace_back(QuadData{pos, size, color, nullptr, glm::vec2{0, 0}, glm::vec2{0, 0}});
+  }
+
+  void RenderQueue::Quad(int layer,
+                         float depth,
+                         const glm::vec2& pos,
+                         const glm::vec2& size,
+                         const Sampler& sampler,
+                         const glm::vec2& texCoord1,
+                         const glm::vec2& texCoord2)
+  {
+    AddItem(layer, depth, &sampler);
+    quads.emplace_back(QuadData{pos, size, glm::vec3{1, 1, 1}, &sampler, texCoord1, texCoord2});
+  }
+
+  void RenderQueue::Flush(Renderer& renderer)
+  {
+    RadixSort();
+    for (auto& item : items)
+    {
+      const QuadData& quad = quads[item.index];
+      if (quad.sampler)
+        renderer.Quad(quad.position, quad.size, *quad.sampler, quad.texCoord1, quad.texCoord2);
+      else
+        renderer.Quad(quad.position, quad.size, quad.color);
+    }
+    items.clear();
+    quads.clear();
+    textureIds.clear();
+  }
+
+  void RenderQueue::AddItem(int layer, float depth, const Sampler* sampler)
+  {
+    CP_ASSERT(layer >= 0 && layer < MAX_NUM_LAYERS, "Layer is out of bounds: %d", layer);
+
+    // Samplers packed in the same atlas page share texture id, id 0 is used for untextured quads
+    uint32_t textureId = 0;
+    if (sampler)
+    {
+      auto it = textureIds.emplace(&sampler->GetRenderSampler(), textureIds.size() + 1).first;
+      textureId = it->second;
+      CP_ASSERT(textureId < (1u << TEXTURE_BITS), "Too many textures in RenderQueue");
+    }
+
+    uint64_t key = (uint64_t)layer << (TEXTURE_BITS + DEPTH_BITS);
+    if (layerSortings[layer] == LayerSorting::Opaque)
+      key |= ((uint64_t)textureId << DEPTH_BITS) | GetSortableDepth(depth);
+    else
+      key |= ((uint64_t)GetSortableDepth(depth) << TEXTURE_BITS) | textureId;
+    items.emplace_back(Item{key, (uint32_t)items.size()});
+  }
+
+  void RenderQueue::RadixSort()
+  {
+    // LSD radix sort on 8 bits at a time, which is stable so equal keys keep their submission order
+    sortBuffer.resize(items.size());
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+      std::array<uint32_t, 256> counts{};
+      for (auto& item : items)
+        counts[(item.key >> shift) & 0xff]++;
+
+      // All items have the same digit, nothing to sort in this pass
+      if (counts[(items.empty() ? 0 : items.front().key >> shift) & 0xff] == items.size())
+        continue;
+
+      uint32_t offset = 0;
+      for (auto& count : counts)
+      {
+        uint32_t c = count;
+        count = offset;
+        offset += c;
+      }
+      for (auto& item : items)
+        sortBuffer[counts[(item.key >> shift) & 0xff]++] = item;
+      items.swap(sortBuffer);
+    }
+  }
+
+  uint32_t RenderQueue::GetSortableDepth(float depth)
+  {
+    // Maps the float bits so that they are ordered as unsigned integers, negative values are flipped completely and
+    // positive values get the sign bit set
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+  }
+}
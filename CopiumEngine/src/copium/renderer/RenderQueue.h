@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "copium/renderer/Renderer.h"
+#include "copium/sampler/Sampler.h"
+#include "copium/util/Common.h"
+#include "copium/util/Enum.h"
+
+#define CP_LAYER_SORTING_ENUMS Opaque, Transparent
+CP_ENUM_CREATOR(Copium, LayerSorting, CP_LAYER_SORTING_ENUMS);
+
+namespace Copium
+{
+  // Collects quads during the frame and submits them to a Renderer sorted by a 64-bit key of (layer, texture, depth).
+  // Layers are always drawn in increasing order. Opaque layers are grouped by texture to minimize texture switches and
+  // batches, so overlapping quads within them may be drawn in any order. Transparent layers are drawn in increasing
+  // depth and are only grouped by texture for quads with the same depth
+  class RenderQueue final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(RenderQueue);
+
+  public:
+    static constexpr int MAX_NUM_LAYERS = 256;
+
+  private:
+    struct Item
+    {
+      uint64_t key;
+      uint32_t index;
+    };
+
+    struct QuadData
+    {
+      glm::vec2 position;
+      glm::vec2 size;
+      glm::vec3 color;
+      const Sampler* sampler;
+      glm::vec2 texCoord1;
+      glm::vec2 texCoord2;
+    };
+
+    std::array<LayerSorting, MAX_NUM_LAYERS> layerSortings;
+    std::vector<Item> items;
+    std::vector<Item> sortBuffer;
+    std::vector<QuadData> quads;
+    std::unordered_map<const Sampler*, uint32_t> textureIds;
+
+  public:
+    RenderQueue();
+
+    void SetLayerSorting(int layer, LayerSorting layerSorting);
+
+    void Quad(int layer, float depth, const glm::vec2& pos, const glm::vec2& size, const glm::vec3& color);
+    void Quad(int layer,
+              float depth,
+              const glm::vec2& pos,
+              const glm::vec2& size,
+              const Sampler& sampler,
+              const glm::vec2& texCoord1 = glm::vec2{0, 0},
+              const glm::vec2& texCoord2 = glm::vec2{1, 1});
+
+    // Sorts the queued quads and draws them with the renderer, which must be between Begin and End
+    void Flush(Renderer& renderer);
+
+    // Maps the depth to an unsigned integer with the same order
+    static uint32_t GetSortableDepth(float depth);
+
+  private:
+    void AddItem(int layer, float depth, const Sampler* sampler);
+    void RadixSort();
+  };
+}
@@ -1,19 +1,37 @@
 #include "copium/renderer/Renderer.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define CP_RENDERER_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CP_RENDERER_NEON
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include "copium/core/Vulkan.h"
 #include "copium/pipeline/PipelineCreator.h"
+#include "copium/renderer/RendererInstance.h"
 #include "copium/renderer/RendererVertex.h"
 
 namespace Copium
 {
   static constexpr int MAX_NUM_QUADS = 10000;
-  static constexpr int MAX_NUM_VERTICES = 4 * MAX_NUM_QUADS;
   static constexpr int MAX_NUM_INDICES = 6 * MAX_NUM_QUADS;
   static constexpr int MAX_NUM_TEXTURES = 32;
+  static constexpr int MAX_NUM_INSTANCES = 100000;  // Not limited by the uint16 index buffer
 
-  Renderer::Renderer(const AssetRef<Pipeline>& pipeline)
-    : ibo{MAX_NUM_INDICES},
+  Renderer::Renderer(const AssetRef<Pipeline>& pipeline, RendererMode mode)
+    : mode{mode},
+      maxQuadCount{mode == RendererMode::Instanced ? MAX_NUM_INSTANCES : MAX_NUM_QUADS},
+      ibo{mode == RendererMode::Instanced ? 6 : MAX_NUM_INDICES},
       pipeline{pipeline},
+      bindless{pipeline.GetAsset().IsBindless()},
+      packed{mode == RendererMode::Vertices && pipeline.GetAsset().GetVertexFormat() == VertexFormat::Packed},
+      textLayoutCache{[this](TextLayout& layout) { InitializeTextVertices(layout); }},
       samplers{MAX_NUM_TEXTURES, &Vulkan::GetEmptyTexture2D().GetAsset()}
   {
     InitializeIndexBuffer();
@@ -21,11 +39,10 @@ namespace Copium
 
   void Renderer::Quad(const glm::vec2& pos, const glm::vec2& size, const glm::vec3& color)
   {
+    if (IsCulled(pos, size))
+      return;
     AllocateQuad();
-    AddVertex(pos, color, -1, glm::vec2{0, 0}, RendererVertex::TYPE_QUAD);
-    AddVertex(glm::vec2{pos.x, pos.y + size.y}, color, -1, glm::vec2{0, 0}, RendererVertex::TYPE_QUAD);
-    AddVertex(pos + size, color, -1, glm::vec2{0, 0}, RendererVertex::TYPE_QUAD);
-    AddVertex(glm::vec2{pos.x + size.x, pos.y}, color, -1, glm::vec2{0, 0}, RendererVertex::TYPE_QUAD);
+    AddQuad(pos, size, color, -1, glm::vec2{0, 0}, glm::vec2{0, 0}, RendererVertex::TYPE_QUAD);
   }
 
   void Renderer::Quad(const glm::vec2& pos,
@@ -34,124 +51,355 @@ namespace Copium
                       const glm::vec2& texCoord1,
                       const glm::vec2& texCoord2)
   {
+    if (IsCulled(pos, size))
+      return;
     AllocateQuad();
-    int texIndex = AllocateSampler(sampler);
-    AddVertex(pos, glm::vec3{1, 1, 1}, texIndex, texCoord1, RendererVertex::TYPE_QUAD);
-    AddVertex(glm::vec2{pos.x, pos.y + size.y},
-              glm::vec3{1, 1, 1},
-              texIndex,
-              glm::vec2{texCoord1.x, texCoord2.y},
-              RendererVertex::TYPE_QUAD);
-    AddVertex(pos + size, glm::vec3{1, 1, 1}, texIndex, texCoord2, RendererVertex::TYPE_QUAD);
-    AddVertex(glm::vec2{pos.x + size.x, pos.y},
-              glm::vec3{1, 1, 1},
-              texIndex,
-              glm::vec2{texCoord2.x, texCoord1.y},
-              RendererVertex::TYPE_QUAD);
+    int texIndex = AllocateSampler(sampler.GetRenderSampler());
+    AddQuad(pos,
+            size,
+            glm::vec3{1, 1, 1},
+            texIndex,
+            sampler.GetRenderTexCoord(texCoord1),
+            sampler.GetRenderTexCoord(texCoord2),
+            RendererVertex::TYPE_QUAD);
   }
 
-  glm::vec2 Renderer::Text(
-    const std::string& str, const glm::vec2& position, const Font& font, float size, const glm::vec3& color)
+  void Renderer::Quads(Span<const SpriteInstance> sprites)
   {
-    glm::vec2 offset = position;
-    for (char c : str)
+    for (const SpriteInstance& sprite : sprites)
     {
-      if (c == ' ')
+      glm::vec2 halfSize = sprite.size * 0.5f;
+      glm::vec2 center = sprite.position + halfSize;
+      float sin = 0.0f;
+      float cos = 1.0f;
+      if (sprite.rotation != 0.0f)
       {
-        const Glyph& glyph = font.GetGlyph(c);
-        offset.x += glyph.advance * size;
-        continue;
+        CP_ASSERT(mode != RendererMode::Instanced, "Rotated sprites are not supported in instanced mode");
+        sin = std::sin(sprite.rotation);
+        cos = std::cos(sprite.rotation);
       }
-      else if (c == '\t')
-      {
-        const Glyph& glyph = font.GetGlyph(' ');
-        offset.x += glyph.advance * size * 4;
+      // Bounds of the rotated sprite
+      glm::vec2 extents{std::abs(halfSize.x * cos) + std::abs(halfSize.y * sin),
+                        std::abs(halfSize.x * sin) + std::abs(halfSize.y * cos)};
+      if (IsCulled(center - extents, extents * 2.0f))
         continue;
-      }
-      else if (c == '\n')
+
+      AllocateQuad();
+      int texIndex = -1;
+      glm::vec2 texCoord1{sprite.texCoords.x, sprite.texCoords.y};
+      glm::vec2 texCoord2{sprite.texCoords.z, sprite.texCoords.w};
+      if (sprite.sampler)
       {
-        offset.y -= font.GetLineHeight() * size;
-        offset.x = position.x;
-        continue;
+        texIndex = AllocateSampler(sprite.sampler->GetRenderSampler());
+        texCoord1 = sprite.sampler->GetRenderTexCoord(texCoord1);
+        texCoord2 = sprite.sampler->GetRenderTexCoord(texCoord2);
       }
-      const Glyph& glyph = font.GetGlyph(c);
+
+      if (mode == RendererMode::Instanced)
+        AddQuad(sprite.position, sprite.size, sprite.color, texIndex, texCoord1, texCoord2, RendererVertex::TYPE_QUAD);
+      else
+        AddSprite(center, halfSize, sin, cos, sprite.color, texIndex, texCoord1, texCoord2);
+    }
+#ifdef CP_RENDERER_SSE
+    // Makes the streamed vertices visible before the buffer is used
+    _mm_sfence();
+#endif
+  }
+
+  void Renderer::Particles(const ParticleEmitter& emitter, const Sampler* sampler)
+  {
+    glm::vec2 texCoord1{0, 0};
+    glm::vec2 texCoord2{1, 1};
+    if (sampler)
+    {
+      texCoord1 = sampler->GetRenderTexCoord(texCoord1);
+      texCoord2 = sampler->GetRenderTexCoord(texCoord2);
+    }
+
+    int texIndex = -1;
+    for (int i = 0; i < emitter.count; i++)
+    {
+      glm::vec2 center{emitter.positionX[i], emitter.positionY[i]};
+      glm::vec2 halfSize{emitter.size[i] * 0.5f};
+      if (IsCulled(center - halfSize, halfSize * 2.0f))
+        continue;
+
+      // The sampler only needs to be reallocated when a new batch has been started
+      int prevQuadCount = quadCount;
       AllocateQuad();
-      int texIndex = AllocateSampler(font);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.l * size, glyph.boundingBox.b * size},
-                color,
-                texIndex,
-                glyph.texCoordBoundingBox.AsLb(),
-                RendererVertex::TYPE_TEXT);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.l * size, glyph.boundingBox.t * size},
-                color,
-                texIndex,
-                glm::vec2{glyph.texCoordBoundingBox.l, glyph.texCoordBoundingBox.t},
-                RendererVertex::TYPE_TEXT);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.r * size, glyph.boundingBox.t * size},
-                color,
-                texIndex,
-                glyph.texCoordBoundingBox.AsRt(),
-                RendererVertex::TYPE_TEXT);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.r * size, glyph.boundingBox.b * size},
+      if (sampler && (texIndex == -1 || quadCount <= prevQuadCount))
+        texIndex = AllocateSampler(sampler->GetRenderSampler());
+
+      glm::vec3 color{emitter.colorR[i], emitter.colorG[i], emitter.colorB[i]};
+      if (mode == RendererMode::Instanced)
+        AddQuad(center - halfSize, halfSize * 2.0f, color, texIndex, texCoord1, texCoord2, RendererVertex::TYPE_QUAD);
+      else
+        AddSprite(center, halfSize, 0.0f, 1.0f, color, texIndex, texCoord1, texCoord2);
+    }
+#ifdef CP_RENDERER_SSE
+    // Makes the streamed vertices visible before the buffer is used
+    _mm_sfence();
+#endif
+  }
+
+  glm::vec2 Renderer::Text(
+    const std::string& str, const glm::vec2& position, const Font& font, float size, const glm::vec3& color)
+  {
+    return AddText(textLayoutCache.GetLayout(str, font, size, false), position, font, color);
+  }
+
+  glm::vec2 Renderer::TextUi(
+    const std::string& str, const glm::vec2& position, const Font& font, float size, const glm::vec3& color)
+  {
+    return AddText(textLayoutCache.GetLayout(str, font, size, true), position, font, color);
+  }
+
+  glm::vec2 Renderer::AddText(const TextLayout& layout,
+                              const glm::vec2& position,
+                              const Font& font,
+                              const glm::vec3& color)
+  {
+    if (IsCulled(position + layout.boundingBox.AsLb(), layout.boundingBox.GetSize(), layout.quads.size()))
+      return position + layout.endOffset;
+
+    if (!layout.glyphCells.empty())
+      font.TouchGlyphCells(layout.glyphCells);
+
+    glm::vec2 boundsMin = position + layout.boundingBox.AsLb();
+    glm::vec2 boundsMax = position + layout.boundingBox.AsRt();
+    bool partiallyVisible = culling && (boundsMin.x < viewRect.l || boundsMin.y < viewRect.b ||
+                                        boundsMax.x > viewRect.r || boundsMax.y > viewRect.t);
+    if (partiallyVisible)
+    {
+      for (auto& quad : layout.quads)
+      {
+        if (IsCulled(position + quad.position, quad.size))
+          continue;
+        AllocateQuad();
+        int texIndex = AllocateSampler(*quad.sampler);
+        AddQuad(position + quad.position,
+                quad.size,
                 color,
                 texIndex,
-                glm::vec2{glyph.texCoordBoundingBox.r, glyph.texCoordBoundingBox.b},
+                quad.texCoord1,
+                quad.texCoord2,
                 RendererVertex::TYPE_TEXT);
-      offset.x += glyph.advance * size;
+      }
+      return position + layout.endOffset;
+    }
+
+    // Fully visible text is copied from the cached vertices of the layout, one copy per sampler run and batch
+    for (size_t i = 0; i < layout.samplerRuns.size(); i++)
+    {
+      const TextLayout::SamplerRun& run = layout.samplerRuns[i];
+      int copied = 0;
+      while (copied < run.quadCount)
+      {
+        if (quadCount == batchQuadCapacity)
+        {
+          Flush();
+          NextBatch();
+        }
+        // Might start a new batch if the samplers of the current one are full
+        int texIndex = AllocateSampler(*run.sampler);
+        int count = std::min(run.quadCount - copied, batchQuadCapacity - quadCount);
+        CopyTextVertices(layout, run.quadOffset + copied, count, position, color, texIndex);
+        quadCount += count;
+        stats.quads += count;
+        copied += count;
+      }
     }
-    return offset;
+    return position + layout.endOffset;
   }
 
-  glm::vec2 Renderer::TextUi(
-    const std::string& str, const glm::vec2& position, const Font& font, float size, const glm::vec3& color)
+  void Renderer::InitializeTextVertices(TextLayout& layout)
   {
-    glm::vec2 offset = position;
-    for (char c : str)
+    layout.vertexData.resize(layout.quads.size() * GetQuadSize());
+    void* mappedVertexBufferCpy = mappedVertexBuffer;
+    mappedVertexBuffer = layout.vertexData.data();
+    for (auto& quad : layout.quads)
     {
-      if (c == ' ')
+      AddQuad(quad.position, quad.size, glm::vec3{1.0f}, 0, quad.texCoord1, quad.texCoord2, RendererVertex::TYPE_TEXT);
+    }
+    mappedVertexBuffer = mappedVertexBufferCpy;
+  }
+
+  void Renderer::CopyTextVertices(const TextLayout& layout,
+                                  int quadOffset,
+                                  int count,
+                                  const glm::vec2& position,
+                                  const glm::vec3& color,
+                                  int texIndex)
+  {
+    std::memcpy(mappedVertexBuffer, layout.vertexData.data() + quadOffset * GetQuadSize(), count * GetQuadSize());
+    if (mode == RendererMode::Instanced)
+    {
+      RendererInstance* instances = (RendererInstance*)mappedVertexBuffer;
+      for (int i = 0; i < count; i++)
       {
-        const Glyph& glyph = font.GetGlyph(c);
-        offset.x += glyph.advance * size;
-        continue;
+        instances[i].position += position;
+        instances[i].color = color;
+        instances[i].texIndex = texIndex;
       }
-      else if (c == '\t')
+      mappedVertexBuffer = instances + count;
+    }
+    else if (packed)
+    {
+      uint32_t packedColor = glm::packUnorm4x8(glm::vec4{color, 1.0f});
+      RendererVertexPacked* vertices = (RendererVertexPacked*)mappedVertexBuffer;
+      for (int i = 0; i < count * 4; i++)
       {
-        const Glyph& glyph = font.GetGlyph(' ');
-        offset.x += glyph.advance * size * 4;
-        continue;
+        vertices[i].position += position;
+        vertices[i].color = packedColor;
+        vertices[i].texIndex = texIndex;
       }
-      else if (c == '\n')
+      mappedVertexBuffer = vertices + count * 4;
+    }
+    else
+    {
+      RendererVertex* vertices = (RendererVertex*)mappedVertexBuffer;
+      for (int i = 0; i < count * 4; i++)
       {
-        offset.y += font.GetLineHeight() * size;
-        offset.x = position.x;
-        continue;
+        vertices[i].position += position;
+        vertices[i].color = color;
+        vertices[i].texIndex = texIndex;
       }
-      const Glyph& glyph = font.GetGlyph(c);
-      AllocateQuad();
-      int texIndex = AllocateSampler(font);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.l * size, -glyph.boundingBox.t * size},
-                color,
-                texIndex,
-                glm::vec2{glyph.texCoordBoundingBox.l, glyph.texCoordBoundingBox.t},
-                RendererVertex::TYPE_TEXT);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.l * size, -glyph.boundingBox.b * size},
-                color,
-                texIndex,
-                glm::vec2{glyph.texCoordBoundingBox.l, glyph.texCoordBoundingBox.b},
-                RendererVertex::TYPE_TEXT);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.r * size, -glyph.boundingBox.b * size},
-                color,
-                texIndex,
-                glm::vec2{glyph.texCoordBoundingBox.r, glyph.texCoordBoundingBox.b},
-                RendererVertex::TYPE_TEXT);
-      AddVertex(offset + glm::vec2{glyph.boundingBox.r * size, -glyph.boundingBox.t * size},
-                color,
-                texIndex,
-                glm::vec2{glyph.texCoordBoundingBox.r, glyph.texCoordBoundingBox.t},
-                RendererVertex::TYPE_TEXT);
-      offset.x += glyph.advance * size;
+      mappedVertexBuffer = vertices + count * 4;
     }
-    return offset;
+  }
+
+  void Renderer::AddQuad(const glm::vec2& position,
+                         const glm::vec2& size,
+                         const glm::vec3& color,
+                         int texIndex,
+                         const glm::vec2& texCoord1,
+                         const glm::vec2& texCoord2,
+                         int type)
+  {
+    if (mode == RendererMode::Instanced)
+    {
+      RendererInstance* instance = (RendererInstance*)mappedVertexBuffer;
+      instance->position = position;
+      instance->size = size;
+      instance->texCoords = glm::vec4{texCoord1, texCoord2};
+      instance->color = color;
+      instance->texIndex = texIndex;
+      instance->type = type;
+      mappedVertexBuffer = instance + 1;
+      return;
+    }
+
+    if (packed)
+    {
+      uint32_t packedColor = glm::packUnorm4x8(glm::vec4{color, 1.0f});
+      AddVertexPacked(position, packedColor, texIndex, texCoord1, type);
+      AddVertexPacked(
+        glm::vec2{position.x, position.y + size.y}, packedColor, texIndex, glm::vec2{texCoord1.x, texCoord2.y}, type);
+      AddVertexPacked(position + size, packedColor, texIndex, texCoord2, type);
+      AddVertexPacked(
+        glm::vec2{position.x + size.x, position.y}, packedColor, texIndex, glm::vec2{texCoord2.x, texCoord1.y}, type);
+      return;
+    }
+
+    AddVertex(position, color, texIndex, texCoord1, type);
+    AddVertex(glm::vec2{position.x, position.y + size.y}, color, texIndex, glm::vec2{texCoord1.x, texCoord2.y}, type);
+    AddVertex(position + size, color, texIndex, texCoord2, type);
+    AddVertex(glm::vec2{position.x + size.x, position.y}, color, texIndex, glm::vec2{texCoord2.x, texCoord1.y}, type);
+  }
+
+  void Renderer::AddSprite(const glm::vec2& center,
+                           const glm::vec2& halfSize,
+                           float sin,
+                           float cos,
+                           const glm::vec3& color,
+                           int texIndex,
+                           const glm::vec2& texCoord1,
+                           const glm::vec2& texCoord2)
+  {
+    // Corners in the same order as AddQuad: (0, 0), (0, 1), (1, 1), (1, 0)
+#if defined(CP_RENDERER_SSE) || defined(CP_RENDERER_NEON)
+    static_assert(sizeof(RendererVertex) == 32, "Vector stores assume RendererVertex is two 16 byte vectors");
+    if (!packed && ((uintptr_t)mappedVertexBuffer & 15) == 0)
+    {
+      // Each vertex is stored as [x, y, r, g] [b, u, v, texIndex | type << 16]
+      int32_t indexAndType = (uint16_t)texIndex | (RendererVertex::TYPE_QUAD << 16);
+#ifdef CP_RENDERER_SSE
+      __m128 offsetX = _mm_setr_ps(-halfSize.x, -halfSize.x, halfSize.x, halfSize.x);
+      __m128 offsetY = _mm_setr_ps(-halfSize.y, halfSize.y, halfSize.y, -halfSize.y);
+      __m128 sinV = _mm_set1_ps(sin);
+      __m128 cosV = _mm_set1_ps(cos);
+      __m128 x =
+        _mm_add_ps(_mm_set1_ps(center.x), _mm_sub_ps(_mm_mul_ps(offsetX, cosV), _mm_mul_ps(offsetY, sinV)));
+      __m128 y =
+        _mm_add_ps(_mm_set1_ps(center.y), _mm_add_ps(_mm_mul_ps(offsetX, sinV), _mm_mul_ps(offsetY, cosV)));
+      __m128 u = _mm_setr_ps(texCoord1.x, texCoord1.x, texCoord2.x, texCoord2.x);
+      __m128 v = _mm_setr_ps(texCoord1.y, texCoord2.y, texCoord2.y, texCoord1.y);
+      __m128 rg = _mm_setr_ps(color.r, color.g, color.r, color.g);
+      __m128 b = _mm_set1_ps(color.b);
+      __m128 bits = _mm_castsi128_ps(_mm_set1_epi32(indexAndType));
+
+      __m128 xy01 = _mm_unpacklo_ps(x, y);
+      __m128 xy23 = _mm_unpackhi_ps(x, y);
+      __m128 bu01 = _mm_unpacklo_ps(b, u);
+      __m128 bu23 = _mm_unpackhi_ps(b, u);
+      __m128 vBits01 = _mm_unpacklo_ps(v, bits);
+      __m128 vBits23 = _mm_unpackhi_ps(v, bits);
+
+      // Non-temporal stores, the vertices are only read by the GPU
+      float* out = (float*)mappedVertexBuffer;
+      _mm_stream_ps(out, _mm_movelh_ps(xy01, rg));
+      _mm_stream_ps(out + 4, _mm_shuffle_ps(bu01, vBits01, _MM_SHUFFLE(1, 0, 1, 0)));
+      _mm_stream_ps(out + 8, _mm_movehl_ps(rg, xy01));
+      _mm_stream_ps(out + 12, _mm_shuffle_ps(bu01, vBits01, _MM_SHUFFLE(3, 2, 3, 2)));
+      _mm_stream_ps(out + 16, _mm_movelh_ps(xy23, rg));
+      _mm_stream_ps(out + 20, _mm_shuffle_ps(bu23, vBits23, _MM_SHUFFLE(1, 0, 1, 0)));
+      _mm_stream_ps(out + 24, _mm_movehl_ps(rg, xy23));
+      _mm_stream_ps(out + 28, _mm_shuffle_ps(bu23, vBits23, _MM_SHUFFLE(3, 2, 3, 2)));
+#else
+      const float offsetXData[4] = {-halfSize.x, -halfSize.x, halfSize.x, halfSize.x};
+      const float offsetYData[4] = {-halfSize.y, halfSize.y, halfSize.y, -halfSize.y};
+      float32x4_t offsetX = vld1q_f32(offsetXData);
+      float32x4_t offsetY = vld1q_f32(offsetYData);
+      float32x4_t x = vmlsq_n_f32(vmlaq_n_f32(vdupq_n_f32(center.x), offsetX, cos), offsetY, sin);
+      float32x4_t y = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(center.y), offsetX, sin), offsetY, cos);
+      const float uData[4] = {texCoord1.x, texCoord1.x, texCoord2.x, texCoord2.x};
+      const float vData[4] = {texCoord1.y, texCoord2.y, texCoord2.y, texCoord1.y};
+
+      // vst4q interleaves lane i of each register into [x, y, r, g] and [b, u, v, bits] of vertex i
+      float32x4x4_t first{{x, y, vdupq_n_f32(color.r), vdupq_n_f32(color.g)}};
+      float32x4x4_t second{{
+        vdupq_n_f32(color.b), vld1q_f32(uData), vld1q_f32(vData), vreinterpretq_f32_s32(vdupq_n_s32(indexAndType))}};
+      float firstData[16];
+      float secondData[16];
+      vst4q_f32(firstData, first);
+      vst4q_f32(secondData, second);
+      float* vertexData = (float*)mappedVertexBuffer;
+      for (int i = 0; i < 4; i++)
+      {
+        vst1q_f32(vertexData + i * 8, vld1q_f32(firstData + i * 4));
+        vst1q_f32(vertexData + i * 8 + 4, vld1q_f32(secondData + i * 4));
+      }
+#endif
+      mappedVertexBuffer = (RendererVertex*)mappedVertexBuffer + 4;
+      return;
+    }
+#endif
+
+    glm::vec2 axisX{halfSize.x * cos, halfSize.x * sin};
+    glm::vec2 axisY{-halfSize.y * sin, halfSize.y * cos};
+    glm::vec2 corners[4] = {
+      center - axisX - axisY, center - axisX + axisY, center + axisX + axisY, center + axisX - axisY};
+    glm::vec2 texCoords[4] = {
+      texCoord1, glm::vec2{texCoord1.x, texCoord2.y}, texCoord2, glm::vec2{texCoord2.x, texCoord1.y}};
+    if (packed)
+    {
+      uint32_t packedColor = glm::packUnorm4x8(glm::vec4{color, 1.0f});
+      for (int i = 0; i < 4; i++)
+        AddVertexPacked(corners[i], packedColor, texIndex, texCoords[i], RendererVertex::TYPE_QUAD);
+      return;
+    }
+    for (int i = 0; i < 4; i++)
+      AddVertex(corners[i], color, texIndex, texCoords[i], RendererVertex::TYPE_QUAD);
   }
 
   void Renderer::AddVertex(
@@ -166,20 +414,125 @@ namespace Copium
     mappedVertexBuffer = (RendererVertex*)mappedVertexBuffer + 1;
   }
 
+  void Renderer::AddVertexPacked(
+    const glm::vec2& position, uint32_t color, int texindex, const glm::vec2& texCoord, int type)
+  {
+    RendererVertexPacked* vertex = (RendererVertexPacked*)mappedVertexBuffer;
+    vertex->position = position;
+    vertex->color = color;
+    vertex->texCoord = glm::packUnorm2x16(texCoord);
+    vertex->texIndex = texindex;
+    vertex->type = type;
+    mappedVertexBuffer = vertex + 1;
+  }
+
   void Renderer::Begin(CommandBuffer& commandBuffer)
   {
+    culling = false;
+    stats = RendererStats{};
+    textLayoutCache.NextFrame();
     pipeline.GetAsset().Bind(commandBuffer);
     ibo.Bind(commandBuffer);
+    if (pipeline.GetAsset().HasPushConstants())
+    {
+      glm::vec2 translation{0, 0};
+      pipeline.GetAsset().PushConstants(commandBuffer, &translation, sizeof(translation));
+    }
     batchIndex = -1;
     NextBatch();
     currentCommandBuffer = &commandBuffer;
   }
 
+  void Renderer::Begin(CommandBuffer& commandBuffer, const BoundingBox& viewRect)
+  {
+    Begin(commandBuffer);
+    culling = true;
+    this->viewRect = viewRect;
+  }
+
   void Renderer::End()
   {
     Flush();
   }
 
+  void Renderer::BeginLayer(RenderLayer& layer)
+  {
+    CP_ASSERT(mode == RendererMode::Vertices, "Layers can only be recorded in vertices mode");
+    culling = false;
+    recordingLayer = &layer;
+    layer.batches.clear();
+    layer.vertexData.clear();
+    layer.quadSize = GetQuadSize();
+    NextBatch();
+  }
+
+  void Renderer::EndLayer()
+  {
+    Flush();
+    RenderLayer& layer = *recordingLayer;
+    recordingLayer = nullptr;
+
+    // The previous buffer is destroyed once the device is idle, in case it is still used by a frame in flight
+    layer.vertexBuffer.reset();
+    if (!layer.vertexData.empty())
+    {
+      layer.vertexBuffer =
+        std::make_unique<Buffer>(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                 layer.vertexData.size(),
+                                 1);
+      layer.vertexBuffer->UpdateStaging(layer.vertexData.data());
+    }
+    layer.vertexData = std::vector<uint8_t>{};
+    layer.dirty = false;
+  }
+
+  void Renderer::DrawLayer(const RenderLayer& layer, const glm::vec2& translation)
+  {
+    CP_ASSERT(!recordingLayer, "Cannot draw a layer while recording a layer");
+    CP_ASSERT(layer.batches.empty() || layer.quadSize == GetQuadSize(), "Layer was recorded with another format");
+    if (layer.batches.empty())
+      return;
+
+    // Draws what has been submitted so far first to keep the order
+    if (quadCount > 0)
+    {
+      Flush();
+      NextBatch();
+    }
+
+    Pipeline& p = pipeline.GetAsset();
+    CP_ASSERT(p.HasPushConstants() || translation == glm::vec2{0, 0},
+              "Translating a layer requires push constants in the pipeline");
+    if (p.HasPushConstants())
+      p.PushConstants(*currentCommandBuffer, &translation, sizeof(translation));
+
+    VkBuffer buffer = *layer.vertexBuffer;
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(*currentCommandBuffer, 0, 1, &buffer, &offset);
+    for (auto& layerBatch : layer.batches)
+    {
+      if (bindless)
+        p.BindDescriptorSets(*currentCommandBuffer);
+      else
+        p.BindDescriptorSets(*currentCommandBuffer, layerBatch.batch->GetDescriptorSet());
+      ibo.Draw(*currentCommandBuffer, layerBatch.quadCount * 6, layerBatch.quadOffset * 4);
+      stats.quads += layerBatch.quadCount;
+      stats.drawCalls++;
+    }
+
+    if (p.HasPushConstants())
+    {
+      glm::vec2 noTranslation{0, 0};
+      p.PushConstants(*currentCommandBuffer, &noTranslation, sizeof(noTranslation));
+    }
+  }
+
+  const RendererStats& Renderer::GetStats() const
+  {
+    return stats;
+  }
+
   Pipeline& Renderer::GetGraphicsPipeline()
   {
     return pipeline.GetAsset();
@@ -192,6 +545,14 @@ namespace Copium
 
   void Renderer::InitializeIndexBuffer()
   {
+    if (mode == RendererMode::Instanced)
+    {
+      // A single quad which is drawn once per instance
+      std::vector<uint16_t> indices{0, 1, 2, 0, 2, 3};
+      ibo.UpdateStaging(indices.data());
+      return;
+    }
+
     CP_ASSERT(MAX_NUM_INDICES < std::numeric_limits<uint16_t>::max(), "Maximum number of indices too big");
 
     std::vector<uint16_t> indices;
@@ -210,6 +571,18 @@ namespace Copium
 
   int Renderer::AllocateSampler(const Sampler& sampler)
   {
+    if (bindless)
+    {
+      // Render textures have one image per frame in flight, which a single array index cannot refer to
+      CP_ASSERT(sampler.GetBindlessIndex() != -1,
+                "Sampler is not part of the bindless texture array, render textures (ColorAttachment) must be drawn "
+                "with a non-bindless Renderer");
+      return sampler.GetBindlessIndex();
+    }
+
+    // Sorted submissions, like from a RenderQueue, mostly hit the last allocated sampler
+    if (textureCount > 0 && samplers[textureCount - 1] == &sampler)
+      return textureCount - 1;
     for (size_t i = 0; i < textureCount; i++)
     {
       if (*samplers[i] == (VkSampler)sampler)
@@ -222,7 +595,9 @@ namespace Copium
       Flush();
       NextBatch();
     }
-    batches[batchIndex]->GetDescriptorSet().SetSamplerDynamic(sampler, 0, textureCount);
+    // Layer batches set all of their samplers once the batch is done
+    if (!recordingLayer)
+      batches[batchIndex]->GetDescriptorSet().SetSamplerDynamic(sampler, 0, textureCount);
 
     samplers[textureCount] = &sampler;
     textureCount++;
@@ -231,36 +606,123 @@ namespace Copium
 
   void Renderer::AllocateQuad()
   {
-    if (quadCount + 1 > MAX_NUM_QUADS)
+    if (quadCount + 1 > batchQuadCapacity)
     {
       Flush();
       NextBatch();
     }
     quadCount++;
+    stats.quads++;
   }
 
   void Renderer::Flush()
   {
-    batches[batchIndex]->GetVertexBuffer().Unmap();
-    batches[batchIndex]->GetVertexBuffer().Bind(*currentCommandBuffer);
+    if (recordingLayer)
+    {
+      FlushLayerBatch();
+      return;
+    }
+
+    GpuProfilerScope profilerScope{*currentCommandBuffer, "Renderer::Flush"};
+    Vulkan::GetTransientVertexBuffer().Commit(vertexAllocation, quadCount * GetQuadSize());
+    TransientVertexBuffer::Bind(*currentCommandBuffer, vertexAllocation);
     Pipeline& p = pipeline.GetAsset();
-    p.SetDescriptorSet(batches[batchIndex]->GetDescriptorSet());
-    p.BindDescriptorSets(*currentCommandBuffer);
-    ibo.Draw(*currentCommandBuffer, quadCount * 6);
+    if (bindless)
+      p.BindDescriptorSets(*currentCommandBuffer);
+    else
+      p.BindDescriptorSets(*currentCommandBuffer, batches[batchIndex]->GetDescriptorSet());
+    if (mode == RendererMode::Instanced)
+      ibo.DrawInstanced(*currentCommandBuffer, quadCount);
+    else
+      ibo.Draw(*currentCommandBuffer, quadCount * 6);
+    stats.drawCalls++;
   }
 
   void Renderer::NextBatch()
   {
-    batchIndex++;
-    std::fill(samplers.begin(), samplers.end(), &Vulkan::GetEmptyTexture2D().GetAsset());
-    if (batchIndex >= batches.size())
+    if (recordingLayer)
+    {
+      NextLayerBatch();
+      return;
+    }
+
+    if (!bindless)
+    {
+      batchIndex++;
+      std::fill(samplers.begin(), samplers.end(), &Vulkan::GetEmptyTexture2D().GetAsset());
+      if (batchIndex >= batches.size())
+      {
+        batches.emplace_back(std::make_unique<Batch>(pipeline, samplers));
+      }
+      batches[batchIndex]->GetDescriptorSet().SetSamplersDynamic(samplers, 0);
+    }
+    vertexAllocation = Vulkan::GetTransientVertexBuffer().Reserve(GetQuadSize(), maxQuadCount * GetQuadSize());
+    mappedVertexBuffer = vertexAllocation.data;
+    batchQuadCapacity = vertexAllocation.size / GetQuadSize();
+    quadCount = 0;
+    textureCount = 0;
+  }
+
+  void Renderer::FlushLayerBatch()
+  {
+    RenderLayer::LayerBatch& layerBatch = recordingLayer->batches.back();
+    layerBatch.quadCount = quadCount;
+    recordingLayer->vertexData.resize((layerBatch.quadOffset + quadCount) * GetQuadSize());
+    if (quadCount == 0)
+    {
+      recordingLayer->batches.pop_back();
+      return;
+    }
+    if (!bindless)
     {
-      batches.emplace_back(std::make_unique<Batch>(pipeline, MAX_NUM_VERTICES, samplers));
+      layerBatch.batch = std::make_unique<Batch>(pipeline, samplers);
+      layerBatch.batch->GetDescriptorSet().SetSamplers(samplers, 0);
     }
-    batches[batchIndex]->GetDescriptorSet().SetSamplersDynamic(samplers, 0);
-    mappedVertexBuffer = (char*)batches[batchIndex]->GetVertexBuffer().Map() +
-                         batches[batchIndex]->GetVertexBuffer().GetPosition(Vulkan::GetSwapChain().GetFlightIndex());
+  }
+
+  void Renderer::NextLayerBatch()
+  {
+    if (!bindless)
+      std::fill(samplers.begin(), samplers.end(), &Vulkan::GetEmptyTexture2D().GetAsset());
+    int quadOffset = recordingLayer->vertexData.size() / GetQuadSize();
+    recordingLayer->batches.emplace_back(RenderLayer::LayerBatch{quadOffset, 0, nullptr});
+    recordingLayer->vertexData.resize((quadOffset + maxQuadCount) * GetQuadSize());
+    mappedVertexBuffer = recordingLayer->vertexData.data() + quadOffset * GetQuadSize();
+    batchQuadCapacity = maxQuadCount;
     quadCount = 0;
     textureCount = 0;
   }
+
+  bool Renderer::IsCulled(const glm::vec2& position, const glm::vec2& size, int quadCount)
+  {
+    if (!culling)
+      return false;
+
+#ifdef CP_RENDERER_SSE
+    // Visible if quadMin <= viewMax and viewMin <= quadMax on both axes, negative sizes are handled by min/max
+    __m128 p = _mm_setr_ps(position.x, position.y, position.x, position.y);
+    __m128 q = _mm_add_ps(p, _mm_setr_ps(size.x, size.y, size.x, size.y));
+    __m128 quadMinMax = _mm_shuffle_ps(_mm_min_ps(p, q), _mm_max_ps(p, q), _MM_SHUFFLE(3, 2, 1, 0));
+    __m128 lhs = _mm_shuffle_ps(quadMinMax, _mm_setr_ps(viewRect.l, viewRect.b, 0, 0), _MM_SHUFFLE(1, 0, 1, 0));
+    __m128 rhs = _mm_shuffle_ps(_mm_setr_ps(viewRect.r, viewRect.t, 0, 0), quadMinMax, _MM_SHUFFLE(3, 2, 1, 0));
+    bool visible = _mm_movemask_ps(_mm_cmple_ps(lhs, rhs)) == 0xf;
+#else
+    glm::vec2 quadMin = glm::min(position, position + size);
+    glm::vec2 quadMax = glm::max(position, position + size);
+    bool visible =
+      quadMin.x <= viewRect.r && quadMin.y <= viewRect.t && viewRect.l <= quadMax.x && viewRect.b <= quadMax.y;
+#endif
+    if (!visible)
+      stats.culledQuads += quadCount;
+    return !visible;
+  }
+
+  int Renderer::GetQuadSize() const
+  {
+    if (mode == RendererMode::Instanced)
+      return sizeof(RendererInstance);
+    if (packed)
+      return 4 * sizeof(RendererVertexPacked);
+    return 4 * sizeof(RendererVertex);
+  }
 }
@@ -6,33 +6,77 @@
 #include "copium/asset/AssetRef.h"
 #include "copium/buffer/CommandBuffer.h"
 #include "copium/buffer/IndexBuffer.h"
+#include "copium/buffer/TransientVertexBuffer.h"
 #include "copium/pipeline/Pipeline.h"
 #include "copium/renderer/Batch.h"
+#include "copium/renderer/ParticleEmitter.h"
+#include "copium/renderer/RenderLayer.h"
+#include "copium/renderer/TextLayoutCache.h"
 #include "copium/sampler/Font.h"
+#include "copium/util/BoundingBox.h"
 #include "copium/util/Common.h"
+#include "copium/util/Enum.h"
+#include "copium/util/Span.h"
+
+#define CP_RENDERER_MODE_ENUMS Vertices, Instanced
+CP_ENUM_CREATOR(Copium, RendererMode, CP_RENDERER_MODE_ENUMS);
 
 namespace Copium
 {
+  struct RendererStats
+  {
+    int quads = 0;
+    int culledQuads = 0;
+    int drawCalls = 0;
+  };
+
+  struct SpriteInstance
+  {
+    glm::vec2 position;
+    glm::vec2 size;
+    float rotation = 0.0f;            // Radians counter-clockwise around the center of the sprite
+    glm::vec4 texCoords{0, 0, 1, 1};  // xy = texCoord at position, zw = texCoord at position + size
+    glm::vec3 color{1, 1, 1};
+    const Sampler* sampler = nullptr;
+  };
+
   class Renderer final
   {
     CP_DELETE_COPY_AND_MOVE_CTOR(Renderer);
 
   private:
+    RendererMode mode;
+    int maxQuadCount;
     IndexBuffer ibo;
     AssetRef<Pipeline> pipeline;
+    bool bindless;
+    bool packed;
     std::vector<std::unique_ptr<Batch>> batches;
+    TextLayoutCache textLayoutCache;
 
     // Temporary data during a render
     CommandBuffer* currentCommandBuffer;
     std::vector<const Sampler*> samplers;
     int batchIndex;
     int quadCount;
+    int batchQuadCapacity;
     int textureCount;
+    TransientVertexBuffer::Allocation vertexAllocation;
     void* mappedVertexBuffer;
     std::map<int, std::unique_ptr<DescriptorSet>> descriptorSets;
+    bool culling;
+    BoundingBox viewRect;
+    RendererStats stats;
+    RenderLayer* recordingLayer = nullptr;
 
   public:
-    Renderer(const AssetRef<Pipeline>& pipeline);
+    // Instanced mode requires a pipeline of type "InstancedRenderer"
+    // In vertices mode the pipeline's vertex format decides if RendererVertex or RendererVertexPacked is written
+    // If the pipeline uses the bindless texture array batches are only split when the vertex memory is full. Render
+    // textures are not part of the array and cannot be drawn by a bindless Renderer
+    // Separate Renderers can record into separate secondary command buffers in parallel, as long as the shared descriptor
+    // sets are set before the recording starts
+    Renderer(const AssetRef<Pipeline>& pipeline, RendererMode mode = RendererMode::Vertices);
 
     void Quad(const glm::vec2& pos, const glm::vec2& size, const glm::vec3& color = glm::vec3{1, 1, 1});
     void Quad(const glm::vec2& pos,
@@ -40,6 +84,11 @@ namespace Copium
               const Sampler& sampler,
               const glm::vec2& texCoord1 = glm::vec2{0, 0},
               const glm::vec2& texCoord2 = glm::vec2{1, 1});
+    // Submits many sprites at once, sprites sorted by sampler avoid texture lookups.
+    // Rotated sprites are not supported in instanced mode
+    void Quads(Span<const SpriteInstance> sprites);
+    // Writes the live particles of the emitter directly as quads centered on the particle positions
+    void Particles(const ParticleEmitter& emitter, const Sampler* sampler = nullptr);
     // Returns the position where the text rendering ended
     glm::vec2 Text(const std::string& str,
                    const glm::vec2& position,
@@ -54,8 +103,21 @@ namespace Copium
                      const glm::vec3& color = glm::vec3(1, 1, 1));
 
     void Begin(CommandBuffer& commandBuffer);
+    // Quads which are completely outside of the view rectangle are skipped
+    void Begin(CommandBuffer& commandBuffer, const BoundingBox& viewRect);
     void End();
 
+    // Records the Quad and Text calls until EndLayer into the layer instead of a command buffer.
+    // Only supported in vertices mode and not between Begin and End, culling is disabled while recording
+    void BeginLayer(RenderLayer& layer);
+    void EndLayer();
+    // Draws a layer recorded by a Renderer with the same pipeline, between Begin and End.
+    // A non-zero translation requires the vertex shader to declare "layout(push_constant) uniform { vec2 translation; }"
+    void DrawLayer(const RenderLayer& layer, const glm::vec2& translation = glm::vec2{0, 0});
+
+    // Stats of the current or last render
+    const RendererStats& GetStats() const;
+
     Pipeline& GetGraphicsPipeline();
     void SetDescriptorSet(const DescriptorSet& descriptorSet);
 
@@ -66,8 +128,39 @@ namespace Copium
     void AllocateQuad();
     void Flush();
     void NextBatch();
+    void FlushLayerBatch();
+    void NextLayerBatch();
+    int GetQuadSize() const;
+    // Counts quadCount culled quads if the area is culled
+    bool IsCulled(const glm::vec2& position, const glm::vec2& size, int quadCount = 1);
 
+    void AddQuad(const glm::vec2& position,
+                 const glm::vec2& size,
+                 const glm::vec3& color,
+                 int texIndex,
+                 const glm::vec2& texCoord1,
+                 const glm::vec2& texCoord2,
+                 int type);
+    void AddSprite(const glm::vec2& center,
+                   const glm::vec2& halfSize,
+                   float sin,
+                   float cos,
+                   const glm::vec3& color,
+                   int texIndex,
+                   const glm::vec2& texCoord1,
+                   const glm::vec2& texCoord2);
     void AddVertex(
       const glm::vec2& position, const glm::vec3& color, int texindex, const glm::vec2& texCoord, int type);
+    void AddVertexPacked(
+      const glm::vec2& position, uint32_t color, int texindex, const glm::vec2& texCoord, int type);
+    glm::vec2 AddText(const TextLayout& layout, const glm::vec2& position, const Font& font, const glm::vec3& color);
+    // Writes the quads of the layout at the origin into its vertex data, called by the TextLayoutCache
+    void InitializeTextVertices(TextLayout& layout);
+    void CopyTextVertices(const TextLayout& layout,
+                          int quadOffset,
+                          int count,
+                          const glm::vec2& position,
+                          const glm::vec3& color,
+                          int texIndex);
   };
 }
@@ -0,0 +1,23 @@
+#include "copium/renderer/RendererInstance.h"
+
+namespace Copium
+{
+  VertexDescriptor RendererInstance::GetDescriptor()
+  {
+    VertexDescriptor descriptor{};
+    descriptor.AddAttribute(0,
+                            0,
+                            VK_FORMAT_R32G32_SFLOAT,
+                            offsetof(RendererInstance, position),
+                            sizeof(RendererInstance),
+                            VK_VERTEX_INPUT_RATE_INSTANCE);
+    descriptor.AddAttribute(0, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(RendererInstance, size), sizeof(RendererInstance));
+    descriptor.AddAttribute(
+      0, 2, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(RendererInstance, texCoords), sizeof(RendererInstance));
+    descriptor.AddAttribute(
+      0, 3, VK_FORMAT_R32G32B32_SFLOAT, offsetof(RendererInstance, color), sizeof(RendererInstance));
+    descriptor.AddAttribute(0, 4, VK_FORMAT_R16_SINT, offsetof(RendererInstance, texIndex), sizeof(RendererInstance));
+    descriptor.AddAttribute(0, 5, VK_FORMAT_R8_SINT, offsetof(RendererInstance, type), sizeof(RendererInstance));
+    return descriptor;
+  }
+}
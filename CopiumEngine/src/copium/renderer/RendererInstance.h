@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "copium/pipeline/VertexDescriptor.h"
+
+namespace Copium
+{
+  // One quad per instance for pipelines of type "InstancedRenderer".
+  // The vertex shader expands the quad from gl_VertexIndex (0-3), the corners are in the order
+  // (0, 0), (0, 1), (1, 1), (1, 0) and are mapped to position + corner * size and mix(texCoords.xy, texCoords.zw, corner)
+  struct RendererInstance
+  {
+    glm::vec2 position;
+    glm::vec2 size;
+    glm::vec4 texCoords;  // xy = texCoord at position, zw = texCoord at position + size
+    glm::vec3 color;
+    int16_t texIndex;
+    int8_t type;
+
+    static VertexDescriptor GetDescriptor();
+  };
+}
@@ -8,8 +8,24 @@ namespace Copium
     descriptor.AddAttribute(0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(RendererVertex, position), sizeof(RendererVertex));
     descriptor.AddAttribute(0, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(RendererVertex, color), sizeof(RendererVertex));
     descriptor.AddAttribute(0, 2, VK_FORMAT_R32G32_SFLOAT, offsetof(RendererVertex, texCoord), sizeof(RendererVertex));
-    descriptor.AddAttribute(0, 3, VK_FORMAT_R8_SINT, offsetof(RendererVertex, texIndex), sizeof(RendererVertex));
+    descriptor.AddAttribute(0, 3, VK_FORMAT_R16_SINT, offsetof(RendererVertex, texIndex), sizeof(RendererVertex));
     descriptor.AddAttribute(0, 4, VK_FORMAT_R8_SINT, offsetof(RendererVertex, type), sizeof(RendererVertex));
     return descriptor;
   }
+
+  VertexDescriptor RendererVertexPacked::GetDescriptor()
+  {
+    VertexDescriptor descriptor{};
+    descriptor.AddAttribute(
+      0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(RendererVertexPacked, position), sizeof(RendererVertexPacked));
+    descriptor.AddAttribute(
+      0, 1, VK_FORMAT_R8G8B8A8_UNORM, offsetof(RendererVertexPacked, color), sizeof(RendererVertexPacked));
+    descriptor.AddAttribute(
+      0, 2, VK_FORMAT_R16G16_UNORM, offsetof(RendererVertexPacked, texCoord), sizeof(RendererVertexPacked));
+    descriptor.AddAttribute(
+      0, 3, VK_FORMAT_R16_SINT, offsetof(RendererVertexPacked, texIndex), sizeof(RendererVertexPacked));
+    descriptor.AddAttribute(
+      0, 4, VK_FORMAT_R8_SINT, offsetof(RendererVertexPacked, type), sizeof(RendererVertexPacked));
+    return descriptor;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "copium/renderer/TextInstance.h"
+
+namespace Copium
+{
+  VertexDescriptor TextInstance::GetDescriptor()
+  {
+    VertexDescriptor descriptor{};
+    descriptor.AddAttribute(0,
+                            0,
+                            VK_FORMAT_R32G32_SFLOAT,
+                            offsetof(TextInstance, position),
+                            sizeof(TextInstance),
+                            VK_VERTEX_INPUT_RATE_INSTANCE);
+    descriptor.AddAttribute(0, 1, VK_FORMAT_R16G16_UINT, offsetof(TextInstance, glyph), sizeof(TextInstance));
+    return descriptor;
+  }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "copium/pipeline/VertexDescriptor.h"
+
+namespace Copium
+{
+  // One glyph per instance for pipelines of type "TextRenderer", 12 bytes instead of the four vertices of a quad.
+  // The vertex shader reads the glyph bounds and texture coordinates from the font's glyph table, two vec4 (l, b, r, t)
+  // per glyph, and the color and scale from the style table, a vec4 color followed by a vec2 scale per style. The
+  // corners are expanded from gl_VertexIndex (0-5) in the order (0, 0), (0, 1), (1, 1), (0, 0), (1, 1), (1, 0) to
+  // position + mix(bounds.xy, bounds.zw, corner) * scale and mix(texCoords.xy, texCoords.zw, corner)
+  struct TextInstance
+  {
+    glm::vec2 position;  // Pen position on the baseline
+    uint16_t glyph;      // Index into the font's glyph table
+    uint16_t style;      // Index into the renderer's style table
+
+    static VertexDescriptor GetDescriptor();
+  };
+}
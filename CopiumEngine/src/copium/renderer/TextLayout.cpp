@@ -0,0 +1,76 @@
+#include "copium/renderer/TextLayout.h"
+
+#include <limits>
+
+#include "copium/util/StringUtil.h"
+
+namespace Copium
+{
+  TextLayout::TextLayout(const std::string& str, const Font& font, float size, bool ui)
+    : boundingBox{0.0f},
+      glyphGeneration{font.GetGlyphGeneration()}
+  {
+    quads.reserve(str.size());
+    glm::vec2 offset{0.0f};
+    glm::vec2 boundsMin{std::numeric_limits<float>::max()};
+    glm::vec2 boundsMax{std::numeric_limits<float>::lowest()};
+    for (size_t i = 0; i < str.size();)
+    {
+      uint32_t c = StringUtil::DecodeUtf8(str, i);
+      if (c == ' ')
+      {
+        const Glyph& glyph = font.GetGlyph(c);
+        offset.x += glyph.advance * size;
+        continue;
+      }
+      else if (c == '\t')
+      {
+        const Glyph& glyph = font.GetGlyph(' ');
+        offset.x += glyph.advance * size * 4;
+        continue;
+      }
+      else if (c == '\n')
+      {
+        offset.y += (ui ? 1 : -1) * font.GetLineHeight() * size;
+        offset.x = 0.0f;
+        continue;
+      }
+      const Glyph& glyph = font.GetGlyph(c);
+      // Whitespace and glyphs which are not generated yet
+      if (glyph.boundingBox.l == glyph.boundingBox.r)
+      {
+        offset.x += glyph.advance * size;
+        continue;
+      }
+      GlyphQuad quad;
+      quad.sampler = glyph.sampler ? glyph.sampler : &font;
+      if (glyph.cell != -1)
+        glyphCells.emplace_back(glyph.cell);
+      if (ui)
+      {
+        quad.position = offset + glm::vec2{glyph.boundingBox.l, -glyph.boundingBox.t} * size;
+        quad.size =
+          glm::vec2{glyph.boundingBox.r - glyph.boundingBox.l, glyph.boundingBox.t - glyph.boundingBox.b} * size;
+        quad.texCoord1 = glm::vec2{glyph.texCoordBoundingBox.l, glyph.texCoordBoundingBox.t};
+        quad.texCoord2 = glm::vec2{glyph.texCoordBoundingBox.r, glyph.texCoordBoundingBox.b};
+      }
+      else
+      {
+        quad.position = offset + glyph.boundingBox.AsLb() * size;
+        quad.size = (glyph.boundingBox.AsRt() - glyph.boundingBox.AsLb()) * size;
+        quad.texCoord1 = glyph.texCoordBoundingBox.AsLb();
+        quad.texCoord2 = glyph.texCoordBoundingBox.AsRt();
+      }
+      boundsMin = glm::min(boundsMin, glm::min(quad.position, quad.position + quad.size));
+      boundsMax = glm::max(boundsMax, glm::max(quad.position, quad.position + quad.size));
+      if (samplerRuns.empty() || samplerRuns.back().sampler != quad.sampler)
+        samplerRuns.emplace_back(SamplerRun{quad.sampler, static_cast<int>(quads.size()), 0});
+      samplerRuns.back().quadCount++;
+      quads.emplace_back(quad);
+      offset.x += glyph.advance * size;
+    }
+    if (!quads.empty())
+      boundingBox = BoundingBox{boundsMin, boundsMax};
+    endOffset = offset;
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "copium/sampler/Font.h"
+#include "copium/util/BoundingBox.h"
+
+namespace Copium
+{
+  // Pre-computed glyph quads of a string, relative to the position the text is drawn at
+  struct TextLayout
+  {
+    struct GlyphQuad
+    {
+      glm::vec2 position;
+      glm::vec2 size;
+      glm::vec2 texCoord1;
+      glm::vec2 texCoord2;
+      const Sampler* sampler;
+    };
+
+    // Consecutive quads which use the same sampler
+    struct SamplerRun
+    {
+      const Sampler* sampler;
+      int quadOffset;
+      int quadCount;
+    };
+
+    std::vector<GlyphQuad> quads;
+    std::vector<SamplerRun> samplerRuns;
+    BoundingBox boundingBox;      // Bounds of all quads
+    glm::vec2 endOffset;          // Where the text rendering ended
+    std::vector<int> glyphCells;  // Dynamically generated glyphs, which are touched every time the layout is drawn
+    int glyphGeneration;          // The layout is outdated if the font's glyph generation differs
+
+    // The quads at the origin in the vertex format of the Renderer drawing the layout, written once when the layout is
+    // cached. The position, color and texture index are applied when the quads are copied into a batch
+    std::vector<char> vertexData;
+
+    // Y-axis is flipped if ui is true, the string is UTF-8 encoded
+    TextLayout(const std::string& str, const Font& font, float size, bool ui);
+  };
+}
@@ -0,0 +1,48 @@
+#include "copium/renderer/TextLayoutCache.h"
+
+#include "copium/util/Hash.h"
+
+namespace Copium
+{
+  TextLayoutCache::TextLayoutCache(const std::function<void(TextLayout& layout)>& initializeVertexData)
+    : initializeVertexData{initializeVertexData}
+  {
+  }
+
+  const TextLayout& TextLayoutCache::GetLayout(const std::string& str, const Font& font, float size, bool ui)
+  {
+    uint64_t hash = Hash::Fnv1a(str);
+    uint64_t fontId = font.GetInstanceId();
+    hash = Hash::Fnv1a(&fontId, sizeof(fontId), hash);
+    hash = Hash::Fnv1a(&size, sizeof(size), hash);
+    hash = Hash::Fnv1a(&ui, sizeof(ui), hash);
+
+    auto it = entries.find(hash);
+    if (it != entries.end() && it->second.str == str && it->second.fontId == fontId && it->second.size == size &&
+        it->second.ui == ui && it->second.layout.glyphGeneration == font.GetGlyphGeneration())
+    {
+      it->second.lastUsedFrame = frame;
+      return it->second.layout;
+    }
+
+    // Either a new layout, an outdated layout or a hash collision, in which case the old layout is replaced
+    Entry entry{str, fontId, size, ui, TextLayout{str, font, size, ui}, frame};
+    initializeVertexData(entry.layout);
+    return entries.insert_or_assign(hash, std::move(entry)).first->second.layout;
+  }
+
+  void TextLayoutCache::NextFrame()
+  {
+    frame++;
+    if (frame % EVICTION_FRAMES != 0)
+      return;
+
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+      if (frame - it->second.lastUsedFrame >= EVICTION_FRAMES)
+        it = entries.erase(it);
+      else
+        ++it;
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "copium/renderer/TextLayout.h"
+#include "copium/sampler/Font.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Caches text layouts keyed by (string, font, size, ui), layouts which haven't been used for a while are evicted.
+  // Fonts are identified by Font::GetInstanceId, since a new font can be allocated at the address of an unloaded one.
+  // Cached layouts are immutable, their vertex data is written by the given function when they are created
+  class TextLayoutCache final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(TextLayoutCache);
+
+  private:
+    static constexpr int EVICTION_FRAMES = 120;
+
+    struct Entry
+    {
+      std::string str;
+      uint64_t fontId;
+      float size;
+      bool ui;
+      TextLayout layout;
+      int lastUsedFrame;
+    };
+
+    std::unordered_map<uint64_t, Entry> entries;
+    std::function<void(TextLayout& layout)> initializeVertexData;
+    int frame = 0;
+
+  public:
+    TextLayoutCache(const std::function<void(TextLayout& layout)>& initializeVertexData);
+
+    const TextLayout& GetLayout(const std::string& str, const Font& font, float size, bool ui);
+
+    // Should be called once per frame
+    void NextFrame();
+  };
+}
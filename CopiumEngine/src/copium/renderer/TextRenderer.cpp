@@ -0,0 +1,232 @@
+#include "copium/renderer/TextRenderer.h"
+
+#include <algorithm>
+
+#include "copium/core/Vulkan.h"
+#include "copium/renderer/TextInstance.h"
+#include "copium/util/StringUtil.h"
+
+namespace Copium
+{
+  static constexpr int MAX_NUM_GLYPHS_PER_BATCH = 100000;
+
+  TextRenderer::TextRenderer(const AssetRef<Pipeline>& pipeline)
+    : descriptorPool{pipeline.GetAsset().GetDescriptorSetCount() * MAX_NUM_FONTS * SwapChain::MAX_FRAMES_IN_FLIGHT,
+                     MAX_NUM_FONTS * SwapChain::MAX_FRAMES_IN_FLIGHT,
+                     2 * MAX_NUM_FONTS * SwapChain::MAX_FRAMES_IN_FLIGHT},
+      pipeline{pipeline},
+      styleBuffer{VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                  MAX_NUM_STYLES * sizeof(TextStyle),
+                  SwapChain::MAX_FRAMES_IN_FLIGHT},
+      mappedStyles{(TextStyle*)styleBuffer.Map()}
+  {
+  }
+
+  TextRenderer::~TextRenderer()
+  {
+    styleBuffer.Unmap();
+  }
+
+  glm::vec2 TextRenderer::Text(
+    const std::string& str, const glm::vec2& position, const Font& font, float size, const glm::vec3& color)
+  {
+    return AddText(str, position, font, size, color, false);
+  }
+
+  glm::vec2 TextRenderer::TextUi(
+    const std::string& str, const glm::vec2& position, const Font& font, float size, const glm::vec3& color)
+  {
+    return AddText(str, position, font, size, color, true);
+  }
+
+  void TextRenderer::Begin(CommandBuffer& commandBuffer)
+  {
+    EvictUnusedFonts();
+    pipeline.GetAsset().Bind(commandBuffer);
+    currentCommandBuffer = &commandBuffer;
+    currentFont = nullptr;
+    NextBatch();
+  }
+
+  void TextRenderer::End()
+  {
+    Flush();
+  }
+
+  Pipeline& TextRenderer::GetGraphicsPipeline()
+  {
+    return pipeline.GetAsset();
+  }
+
+  void TextRenderer::SetDescriptorSet(const DescriptorSet& descriptorSet)
+  {
+    pipeline.GetAsset().SetDescriptorSet(descriptorSet);
+  }
+
+  glm::vec2 TextRenderer::AddText(const std::string& str,
+                                  const glm::vec2& position,
+                                  const Font& font,
+                                  float size,
+                                  const glm::vec3& color,
+                                  bool ui)
+  {
+    SetFont(font);
+    uint16_t style = AllocateStyle(color, size, ui);
+    glm::vec2 offset{0.0f};
+    for (size_t i = 0; i < str.size();)
+    {
+      uint32_t c = StringUtil::DecodeUtf8(str, i);
+      if (c == '\t')
+      {
+        offset.x += font.GetGlyph(' ').advance * size * 4;
+        continue;
+      }
+      else if (c == '\n')
+      {
+        offset.y += (ui ? 1 : -1) * font.GetLineHeight() * size;
+        offset.x = 0.0f;
+        continue;
+      }
+
+      int glyphIndex = font.GetGlyphTableIndex(c);
+      Glyph glyph = font.GetGlyph(glyphIndex);
+      // Whitespace doesn't need an instance
+      if (glyph.boundingBox.l != glyph.boundingBox.r)
+      {
+        AllocateInstance();
+        TextInstance* instance = (TextInstance*)mappedVertexBuffer;
+        instance->position = position + offset;
+        instance->glyph = glyphIndex;
+        instance->style = style;
+        mappedVertexBuffer = instance + 1;
+      }
+      offset.x += glyph.advance * size;
+    }
+    return position + offset;
+  }
+
+  uint16_t TextRenderer::AllocateStyle(const glm::vec3& color, float size, bool ui)
+  {
+    // The styles are written directly to the style buffer of the current frame in flight
+    uint64_t frame = Vulkan::GetSwapChain().GetFrameCount();
+    if (frame != styleFrame)
+    {
+      styleIndices.clear();
+      styleFrame = frame;
+    }
+
+    std::array<float, 5> key{color.r, color.g, color.b, size, ui ? 1.0f : 0.0f};
+    auto it = styleIndices.find(key);
+    if (it != styleIndices.end())
+      return it->second;
+
+    CP_ASSERT(styleIndices.size() < MAX_NUM_STYLES, "Too many text styles in one frame");
+    uint16_t index = styleIndices.size();
+    TextStyle& style = mappedStyles[Vulkan::GetSwapChain().GetFlightIndex() * MAX_NUM_STYLES + index];
+    style.color = glm::vec4{color, 1.0f};
+    style.scale = glm::vec2{size, ui ? -size : size};
+    styleIndices.emplace(key, index);
+    return index;
+  }
+
+  void TextRenderer::AllocateInstance()
+  {
+    if (instanceCount + 1 > batchInstanceCapacity)
+    {
+      Flush();
+      NextBatch();
+    }
+    instanceCount++;
+  }
+
+  void TextRenderer::SetFont(const Font& font)
+  {
+    if (currentFont == &font)
+      return;
+
+    if (instanceCount > 0)
+    {
+      Flush();
+      NextBatch();
+    }
+    currentFont = &font;
+  }
+
+  const DescriptorSet& TextRenderer::GetFontDescriptorSet(const Font& font)
+  {
+    uint64_t frame = Vulkan::GetSwapChain().GetFrameCount();
+    auto it = fontDescriptorSets.find(font.GetInstanceId());
+    if (it != fontDescriptorSets.end())
+    {
+      it->second.lastUsedFrame = frame;
+      return *it->second.descriptorSet;
+    }
+
+    // Descriptor sets can only be rewritten once the frames in flight which used them have finished
+    auto unusedIt = std::find_if(unusedFontDescriptorSets.begin(),
+                                 unusedFontDescriptorSets.end(),
+                                 [frame](const FontDescriptorSet& unused)
+                                 { return unused.lastUsedFrame + SwapChain::MAX_FRAMES_IN_FLIGHT <= frame; });
+    std::unique_ptr<DescriptorSet> descriptorSet;
+    if (unusedIt != unusedFontDescriptorSets.end())
+    {
+      descriptorSet = std::move(unusedIt->descriptorSet);
+      *unusedIt = std::move(unusedFontDescriptorSets.back());
+      unusedFontDescriptorSets.pop_back();
+    }
+    else
+    {
+      CP_ASSERT(fontDescriptorSets.size() + unusedFontDescriptorSets.size() < MAX_NUM_FONTS,
+                "Too many fonts used by the TextRenderer");
+      descriptorSet = pipeline.GetAsset().CreateDescriptorSet(descriptorPool, 0);
+      descriptorSet->SetStorageBuffer(styleBuffer, 2);
+    }
+    descriptorSet->SetSampler(font, 0);
+    descriptorSet->SetStorageBuffer(font.GetGlyphTable(), 1);
+    return *fontDescriptorSets.emplace(font.GetInstanceId(), FontDescriptorSet{std::move(descriptorSet), frame})
+              .first->second.descriptorSet;
+  }
+
+  void TextRenderer::EvictUnusedFonts()
+  {
+    // Fonts which weren't drawn in the previous frame might have been destroyed
+    uint64_t frame = Vulkan::GetSwapChain().GetFrameCount();
+    if (frame == fontFrame)
+      return;
+    fontFrame = frame;
+
+    for (auto it = fontDescriptorSets.begin(); it != fontDescriptorSets.end();)
+    {
+      if (it->second.lastUsedFrame + 1 < frame)
+      {
+        unusedFontDescriptorSets.emplace_back(std::move(it->second));
+        it = fontDescriptorSets.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  void TextRenderer::Flush()
+  {
+    Vulkan::GetTransientVertexBuffer().Commit(vertexAllocation, instanceCount * sizeof(TextInstance));
+    if (instanceCount == 0)
+      return;
+
+    const DescriptorSet& descriptorSet = GetFontDescriptorSet(*currentFont);
+    TransientVertexBuffer::Bind(*currentCommandBuffer, vertexAllocation);
+    pipeline.GetAsset().BindDescriptorSets(*currentCommandBuffer, descriptorSet);
+    vkCmdDraw(*currentCommandBuffer, 6, instanceCount, 0, 0);
+  }
+
+  void TextRenderer::NextBatch()
+  {
+    vertexAllocation = Vulkan::GetTransientVertexBuffer().Reserve(sizeof(TextInstance),
+                                                                  MAX_NUM_GLYPHS_PER_BATCH * sizeof(TextInstance));
+    mappedVertexBuffer = vertexAllocation.data;
+    batchInstanceCapacity = vertexAllocation.size / sizeof(TextInstance);
+    instanceCount = 0;
+  }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "copium/buffer/CommandBuffer.h"
+#include "copium/buffer/StorageBuffer.h"
+#include "copium/buffer/TransientVertexBuffer.h"
+#include "copium/pipeline/Pipeline.h"
+#include "copium/sampler/Font.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Draws text as one TextInstance per glyph, the quads are expanded on the GPU from the font's glyph table.
+  // Requires a pipeline of type "TextRenderer" where set 0 declares the font sampler2D at binding 0, the glyph table
+  // storage buffer at binding 1 and the style table storage buffer at binding 2.
+  // Only the glyphs in the font's atlas are supported, other glyphs are drawn as '?', use Renderer::Text for those.
+  // Fonts are identified by Font::GetInstanceId, and the descriptor set of a font which wasn't drawn in the previous
+  // frame is reused for other fonts once no frame in flight uses it
+  class TextRenderer final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(TextRenderer);
+
+  public:
+    static const int MAX_NUM_STYLES = 4096;  // Per frame
+    static const int MAX_NUM_FONTS = 16;
+
+  private:
+    struct TextStyle
+    {
+      glm::vec4 color;
+      glm::vec2 scale;  // The y-axis is flipped for ui text
+      glm::vec2 padding;
+    };
+
+    struct FontDescriptorSet
+    {
+      std::unique_ptr<DescriptorSet> descriptorSet;
+      uint64_t lastUsedFrame;
+    };
+
+    DescriptorPool descriptorPool;
+    AssetRef<Pipeline> pipeline;
+    StorageBuffer styleBuffer;
+    TextStyle* mappedStyles;
+    std::unordered_map<uint64_t, FontDescriptorSet> fontDescriptorSets;
+    std::vector<FontDescriptorSet> unusedFontDescriptorSets;
+    uint64_t fontFrame = -1;
+    std::map<std::array<float, 5>, uint16_t> styleIndices;
+    uint64_t styleFrame = -1;
+
+    // Temporary data during a render
+    CommandBuffer* currentCommandBuffer;
+    const Font* currentFont;
+    int instanceCount;
+    int batchInstanceCapacity;
+    TransientVertexBuffer::Allocation vertexAllocation;
+    void* mappedVertexBuffer;
+
+  public:
+    TextRenderer(const AssetRef<Pipeline>& pipeline);
+    ~TextRenderer();
+
+    // Returns the position where the text rendering ended
+    glm::vec2 Text(const std::string& str,
+                   const glm::vec2& position,
+                   const Font& font,
+                   float size,
+                   const glm::vec3& color = glm::vec3(1, 1, 1));
+    // Returns the position where the text rendering ended
+    glm::vec2 TextUi(const std::string& str,
+                     const glm::vec2& position,
+                     const Font& font,
+                     float size,
+                     const glm::vec3& color = glm::vec3(1, 1, 1));
+
+    void Begin(CommandBuffer& commandBuffer);
+    void End();
+
+    Pipeline& GetGraphicsPipeline();
+    void SetDescriptorSet(const DescriptorSet& descriptorSet);
+
+  private:
+    glm::vec2 AddText(const std::string& str,
+                      const glm::vec2& position,
+                      const Font& font,
+                      float size,
+                      const glm::vec3& color,
+                      bool ui);
+    uint16_t AllocateStyle(const glm::vec3& color, float size, bool ui);
+    void AllocateInstance();
+    void SetFont(const Font& font);
+    const DescriptorSet& GetFontDescriptorSet(const Font& font);
+    void EvictUnusedFonts();
+    void Flush();
+    void NextBatch();
+  };
+}
@@ -0,0 +1,166 @@
+#include "copium/renderer/Tilemap.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Copium
+{
+  Tilemap::Tilemap(int width,
+                   int height,
+                   const glm::vec2& position,
+                   const glm::vec2& tileSize,
+                   const Sampler& tileset,
+                   const glm::ivec2& tilesetSize)
+    : width{width},
+      height{height},
+      chunksX{(width + CHUNK_SIZE - 1) / CHUNK_SIZE},
+      chunksY{(height + CHUNK_SIZE - 1) / CHUNK_SIZE},
+      position{position},
+      tileSize{tileSize},
+      tileset{tileset},
+      tilesetSize{tilesetSize},
+      tiles(width * height, EMPTY_TILE),
+      chunks(chunksX * chunksY),
+      chunkLastVisible(chunksX * chunksY, 0)
+  {
+    CP_ASSERT(width > 0 && height > 0, "Tilemap size must be positive");
+    CP_ASSERT(tileSize.x > 0 && tileSize.y > 0, "Tile size must be positive");
+    CP_ASSERT(tilesetSize.x * tilesetSize.y <= INT16_MAX, "Too many tiles in the tileset");
+  }
+
+  void Tilemap::SetTile(int x, int y, int tile)
+  {
+    CP_ASSERT(x >= 0 && x < width && y >= 0 && y < height, "Tile out of bounds");
+    CP_ASSERT(tile >= EMPTY_TILE && tile < tilesetSize.x * tilesetSize.y, "Tile index out of bounds");
+
+    int16_t& current = tiles[x + y * width];
+    if (current == tile)
+      return;
+    current = tile;
+
+    std::unique_ptr<RenderLayer>& chunk = chunks[x / CHUNK_SIZE + (y / CHUNK_SIZE) * chunksX];
+    if (chunk)
+      chunk->MarkDirty();
+  }
+
+  int Tilemap::GetTile(int x, int y) const
+  {
+    CP_ASSERT(x >= 0 && x < width && y >= 0 && y < height, "Tile out of bounds");
+    return tiles[x + y * width];
+  }
+
+  void Tilemap::Update(Renderer& renderer, const BoundingBox& viewRect)
+  {
+    stats.rebuiltChunks = 0;
+    updateCount++;
+    glm::ivec2 min;
+    glm::ivec2 max;
+    if (GetVisibleChunks(viewRect, min, max))
+    {
+      for (int y = min.y; y <= max.y; y++)
+      {
+        for (int x = min.x; x <= max.x; x++)
+        {
+          int index = x + y * chunksX;
+          std::unique_ptr<RenderLayer>& chunk = chunks[index];
+          if (!chunk)
+          {
+            chunk = std::make_unique<RenderLayer>();
+            residentChunks.emplace_back(index);
+          }
+          chunkLastVisible[index] = updateCount;
+          if (chunk->IsDirty())
+          {
+            RecordChunk(renderer, x, y);
+            stats.rebuiltChunks++;
+          }
+        }
+      }
+    }
+    EvictChunks();
+    stats.residentChunks = residentChunks.size();
+  }
+
+  void Tilemap::Render(Renderer& renderer, const BoundingBox& viewRect)
+  {
+    stats.visibleChunks = 0;
+    glm::ivec2 min;
+    glm::ivec2 max;
+    if (!GetVisibleChunks(viewRect, min, max))
+      return;
+
+    for (int y = min.y; y <= max.y; y++)
+    {
+      for (int x = min.x; x <= max.x; x++)
+      {
+        const std::unique_ptr<RenderLayer>& chunk = chunks[x + y * chunksX];
+        CP_ASSERT(chunk && !chunk->IsDirty(), "Visible chunk has not been updated");
+        renderer.DrawLayer(*chunk);
+        stats.visibleChunks++;
+      }
+    }
+  }
+
+  const TilemapStats& Tilemap::GetStats() const
+  {
+    return stats;
+  }
+
+  void Tilemap::RecordChunk(Renderer& renderer, int chunkX, int chunkY)
+  {
+    glm::vec2 texCoordSize = 1.0f / glm::vec2{tilesetSize};
+    int xEnd = std::min((chunkX + 1) * CHUNK_SIZE, width);
+    int yEnd = std::min((chunkY + 1) * CHUNK_SIZE, height);
+
+    renderer.BeginLayer(*chunks[chunkX + chunkY * chunksX]);
+    for (int y = chunkY * CHUNK_SIZE; y < yEnd; y++)
+    {
+      for (int x = chunkX * CHUNK_SIZE; x < xEnd; x++)
+      {
+        int tile = tiles[x + y * width];
+        if (tile == EMPTY_TILE)
+          continue;
+
+        // Textures are flipped vertically when loaded, so the rows of the tileset are counted from the bottom
+        glm::vec2 texCoord =
+          glm::vec2{tile % tilesetSize.x, tilesetSize.y - 1 - tile / tilesetSize.x} * texCoordSize;
+        renderer.Quad(position + glm::vec2{x, y} * tileSize, tileSize, tileset, texCoord, texCoord + texCoordSize);
+      }
+    }
+    renderer.EndLayer();
+  }
+
+  void Tilemap::EvictChunks()
+  {
+    // Layers release their GPU resources once the device is idle, so frames in flight can still draw evicted chunks.
+    // Evicting in rounds keeps the idle waits rare
+    if (updateCount % EVICTION_UPDATES != 0)
+      return;
+
+    for (size_t i = 0; i < residentChunks.size();)
+    {
+      int index = residentChunks[i];
+      if (updateCount - chunkLastVisible[index] < EVICTION_UPDATES)
+      {
+        i++;
+        continue;
+      }
+      chunks[index].reset();
+      residentChunks[i] = residentChunks.back();
+      residentChunks.pop_back();
+    }
+  }
+
+  bool Tilemap::GetVisibleChunks(const BoundingBox& viewRect, glm::ivec2& min, glm::ivec2& max) const
+  {
+    glm::vec2 chunkSize = tileSize * (float)CHUNK_SIZE;
+    glm::vec2 viewMin = (glm::vec2{viewRect.l, viewRect.b} - position) / chunkSize;
+    glm::vec2 viewMax = (glm::vec2{viewRect.r, viewRect.t} - position) / chunkSize;
+    if (viewMax.x < 0 || viewMax.y < 0 || viewMin.x >= chunksX || viewMin.y >= chunksY)
+      return false;
+
+    min = glm::max(glm::ivec2{glm::floor(viewMin)}, glm::ivec2{0, 0});
+    max = glm::min(glm::ivec2{glm::floor(viewMax)}, glm::ivec2{chunksX - 1, chunksY - 1});
+    return true;
+  }
+}
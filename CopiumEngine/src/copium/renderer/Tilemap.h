@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "copium/renderer/RenderLayer.h"
+#include "copium/renderer/Renderer.h"
+#include "copium/sampler/Sampler.h"
+#include "copium/util/BoundingBox.h"
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  struct TilemapStats
+  {
+    int visibleChunks = 0;
+    int rebuiltChunks = 0;
+    int residentChunks = 0;
+  };
+
+  // Grid of tiles from a tileset texture, split into chunks of CHUNK_SIZE x CHUNK_SIZE tiles. Each chunk is recorded
+  // into its own RenderLayer the first time it is visible and only rerecorded when one of its tiles changes, so drawing
+  // the map costs one draw per visible chunk instead of one quad per visible tile. Chunks which haven't been visible
+  // for EVICTION_UPDATES calls to Update are released, at most twice that long after, and recorded again once they
+  // become visible
+  class Tilemap final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(Tilemap);
+
+  public:
+    static const int CHUNK_SIZE = 32;
+    static const int EMPTY_TILE = -1;
+    static const int EVICTION_UPDATES = 120;
+
+  private:
+    int width;
+    int height;
+    int chunksX;
+    int chunksY;
+    glm::vec2 position;
+    glm::vec2 tileSize;
+    const Sampler& tileset;
+    glm::ivec2 tilesetSize;
+    std::vector<int16_t> tiles;
+    std::vector<std::unique_ptr<RenderLayer>> chunks;  // nullptr while the chunk is not resident
+    std::vector<uint64_t> chunkLastVisible;            // Update count when the chunk was last visible
+    std::vector<int> residentChunks;
+    uint64_t updateCount = 0;
+    TilemapStats stats;
+
+  public:
+    // tilesetSize is the number of tiles in the tileset texture horizontally and vertically, tile index 0 is the top
+    // left tile of the image. The tileset has to outlive the Tilemap
+    Tilemap(int width,
+            int height,
+            const glm::vec2& position,
+            const glm::vec2& tileSize,
+            const Sampler& tileset,
+            const glm::ivec2& tilesetSize);
+
+    void SetTile(int x, int y, int tile);
+    int GetTile(int x, int y) const;
+
+    // Rerecords the visible chunks with changed tiles, must be called outside of the renderer's Begin and End
+    void Update(Renderer& renderer, const BoundingBox& viewRect);
+    // Draws the visible chunks, must be called between the renderer's Begin and End
+    void Render(Renderer& renderer, const BoundingBox& viewRect);
+
+    // Stats of the last Update and Render
+    const TilemapStats& GetStats() const;
+
+  private:
+    void RecordChunk(Renderer& renderer, int chunkX, int chunkY);
+    void EvictChunks();
+    // Returns false if no chunks are visible
+    bool GetVisibleChunks(const BoundingBox& viewRect, glm::ivec2& min, glm::ivec2& max) const;
+  };
+}
@@ -5,78 +5,62 @@
 #include "copium/buffer/Buffer.h"
 #include "copium/core/Vulkan.h"
 #include "copium/sampler/Image.h"
+#include "copium/util/FileSystem.h"
+#include "copium/util/Hash.h"
+#include "copium/util/RuntimeException.h"
+#include "copium/util/StringUtil.h"
 
 namespace Copium
 {
+  std::atomic<uint64_t> Font::nextInstanceId{0};
+
   Font::Font(const MetaFile& metaFile)
-    : Sampler{SamplerCreator{metaFile.GetMetaClass("Font")}}
+    : Sampler{SamplerCreator{metaFile.GetMetaClass("Font")}},
+      instanceId{nextInstanceId++}
   {
-    msdfgen::FreetypeHandle* ft = msdfgen::initializeFreetype();
-    CP_ASSERT(ft, "Failed to initialize FreeType");  // TODO: Move to Vulkan singleton class?
+    freetype = msdfgen::initializeFreetype();
+    CP_ASSERT(freetype, "Failed to initialize FreeType");  // TODO: Move to Vulkan singleton class?
     std::string fontPath = metaFile.GetMetaClass("Font").GetValue("filepath");
-    msdfgen::FontHandle* font = msdfgen::loadFont(ft, fontPath.c_str());
+    font = msdfgen::loadFont(freetype, fontPath.c_str());
     CP_ASSERT(font, "Failed to initialize font: %s", fontPath.c_str());
 
-    std::vector<msdf_atlas::GlyphGeometry> glyphs;
-    msdf_atlas::FontGeometry fontGeometry(&glyphs);
-    fontGeometry.loadCharset(font, 1.0, msdf_atlas::Charset::ASCII);
-    const double maxCornerAngle = 3.0;
-    for (msdf_atlas::GlyphGeometry& glyph : glyphs)
+    std::vector<char> fontData = FileSystem::ReadFile(fontPath);
+    uint64_t hash = Hash::Fnv1a(fontData.data(), fontData.size());
+    const double parameters[] = {
+      ATLAS_CACHE_VERSION, ATLAS_MIN_SCALE, ATLAS_PIXEL_RANGE, ATLAS_MITER_LIMIT, ATLAS_PADDING};
+    hash = Hash::Fnv1a(&parameters, sizeof(parameters), hash);
+
+    std::string cacheFilename = ".cache/" + fontPath + ".atlas";
+    bool loaded = false;
+    try
     {
-      glyph.edgeColoring(&msdfgen::edgeColoringInkTrap, maxCornerAngle, 0);
+      if (FileSystem::FileExists(cacheFilename))
+      {
+        CP_DEBUG("Loading cached font atlas: %s", fontPath.c_str());
+        loaded = LoadCachedAtlas(cacheFilename, hash);
+      }
     }
-    msdf_atlas::TightAtlasPacker packer;
-    packer.setDimensionsConstraint(msdf_atlas::TightAtlasPacker::DimensionsConstraint::SQUARE);
-    packer.setMinimumScale(64.0);
-    packer.setPixelRange(2.0);
-    packer.setMiterLimit(1.0);
-    packer.setPadding(2);
-    packer.pack(glyphs.data(), glyphs.size());
-
-    int width = 0, height = 0;
-    packer.getDimensions(width, height);
-
-    msdf_atlas::
-      ImmediateAtlasGenerator<float, 3, msdf_atlas::msdfGenerator, msdf_atlas::BitmapAtlasStorage<msdf_atlas::byte, 3>>
-        generator(width, height);
-    msdf_atlas::GeneratorAttributes attributes;
-    generator.setAttributes(attributes);
-    generator.setThreadCount(4);
-    generator.generate(glyphs.data(), glyphs.size());
-
-    msdf_atlas::BitmapAtlasStorage<msdf_atlas::byte, 3> pixels = generator.atlasStorage();
-    std::vector<uint8_t> data;
-    data.resize(width * height * 4);
-    msdfgen::Bitmap<msdf_atlas::byte, 3> bitmap = (msdfgen::Bitmap<msdf_atlas::byte, 3>)pixels;
-    for (int i = 0; i < width * height; i++)
+    catch (const RuntimeException& e)
     {
-      data[i * 4] = bitmap[i * 3];
-      data[i * 4 + 1] = bitmap[i * 3 + 1];
-      data[i * 4 + 2] = bitmap[i * 3 + 2];
-      data[i * 4 + 3] = 255;
+      CP_WARN("Cached font atlas is invalid, recreating it");
     }
-    InitializeTextureImageFromData(data.data(), width, height);
-
-    for (msdf_atlas::GlyphGeometry& glyphGeom : glyphs)
+    if (!loaded)
     {
-      Glyph glyph;
-      glyph.advance = glyphGeom.getAdvance();
-      double l, b, r, t;
-      glyphGeom.getQuadPlaneBounds(l, b, r, t);
-      glyph.boundingBox = BoundingBox{(float)l, (float)b, (float)r, (float)t};
-      glyphGeom.getQuadAtlasBounds(l, b, r, t);
-      glyph.texCoordBoundingBox = BoundingBox{(float)l / width, (float)b / height, (float)r / width, (float)t / height};
-      this->glyphs.emplace((char)glyphGeom.getCodepoint(), glyph);
+      CP_DEBUG("Generating font atlas: %s", fontPath.c_str());
+      GenerateAtlas(cacheFilename, hash);
     }
-    lineHeight = fontGeometry.getMetrics().lineHeight;
-    baseHeight = fontGeometry.getMetrics().ascenderY;
 
-    msdfgen::destroyFont(font);
-    msdfgen::deinitializeFreetype(ft);
+    glyphCache = std::make_unique<GlyphCache>(font, geometryScale, SamplerCreator{metaFile.GetMetaClass("Font")});
+    InitializeGlyphTable();
   }
 
   Font::~Font()
   {
+    // Joins the worker thread before the font handle is destroyed
+    glyphCache.reset();
+    msdfgen::destroyFont(font);
+    msdfgen::deinitializeFreetype(freetype);
+
     VkImage imageCpy = image;
     VkDeviceMemory imageMemoryCpy = imageMemory;
     VkImageView imageViewCpy = imageView;
@@ -99,10 +83,43 @@ namespace Copium
     return imageInfo;
   }
 
-  const Glyph& Font::GetGlyph(char c) const
+  Glyph Font::GetGlyph(uint32_t codepoint) const
   {
-    CP_ASSERT(glyphs.find(c) != glyphs.end(), "Glyph not found: %c", c);
-    return glyphs.find(c)->second;
+    if (codepoint < NUM_GLYPHS && validGlyphs[codepoint])
+      return glyphs[codepoint];
+
+    Glyph glyph{0.0f, BoundingBox{0.0f}, BoundingBox{0.0f}};
+    GlyphStatus status = glyphCache->GetGlyph(codepoint, glyph);
+    if (status == GlyphStatus::Missing && validGlyphs['?'])
+      return glyphs['?'];
+    return glyph;
+  }
+
+  int Font::GetGlyphGeneration() const
+  {
+    return glyphCache->GetGeneration();
+  }
+
+  uint64_t Font::GetInstanceId() const
+  {
+    return instanceId;
+  }
+
+  void Font::TouchGlyphCells(const std::vector<int>& cells) const
+  {
+    glyphCache->TouchCells(cells);
+  }
+
+  const StorageBuffer& Font::GetGlyphTable() const
+  {
+    return *glyphTable;
+  }
+
+  int Font::GetGlyphTableIndex(uint32_t codepoint) const
+  {
+    if (codepoint < NUM_GLYPHS && validGlyphs[codepoint])
+      return codepoint;
+    return '?';
   }
 
   float Font::GetLineHeight() const
@@ -119,8 +136,9 @@ namespace Copium
   {
     BoundingBox boundingBox{0.0f};
     glm::vec2 offset{0.0f};
-    for (auto c : str)
+    for (size_t i = 0; i < str.size();)
     {
+      uint32_t c = StringUtil::DecodeUtf8(str, i);
       if (c == ' ')
       {
         const Glyph& glyph = GetGlyph(c);
@@ -154,6 +172,128 @@ namespace Copium
     return boundingBox;
   }
 
+  bool Font::LoadCachedAtlas(const std::string& cacheFilename, uint64_t hash)
+  {
+    std::vector<char> data = FileSystem::ReadFile(cacheFilename);
+    AtlasCacheHeader header;
+    CP_ASSERT(data.size() >= sizeof(header), "Font atlas cache is too small");
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != ATLAS_CACHE_MAGIC || header.hash != hash)
+      return false;
+
+    size_t glyphsOffset = sizeof(header);
+    size_t pixelsOffset = glyphsOffset + header.glyphCount * sizeof(AtlasCacheGlyph);
+    CP_ASSERT(data.size() == pixelsOffset + (size_t)header.width * header.height * 4, "Font atlas cache size mismatch");
+
+    glyphs.resize(NUM_GLYPHS);
+    validGlyphs.assign(NUM_GLYPHS, false);
+    for (uint32_t i = 0; i < header.glyphCount; i++)
+    {
+      AtlasCacheGlyph cachedGlyph;
+      memcpy(&cachedGlyph, data.data() + glyphsOffset + i * sizeof(AtlasCacheGlyph), sizeof(AtlasCacheGlyph));
+      CP_ASSERT(cachedGlyph.codepoint < NUM_GLYPHS, "Invalid glyph in font atlas cache");
+      glyphs[cachedGlyph.codepoint] =
+        Glyph{cachedGlyph.advance, cachedGlyph.boundingBox, cachedGlyph.texCoordBoundingBox};
+      validGlyphs[cachedGlyph.codepoint] = true;
+    }
+    lineHeight = header.lineHeight;
+    baseHeight = header.baseHeight;
+    geometryScale = header.geometryScale;
+    InitializeTextureImageFromData((const uint8_t*)data.data() + pixelsOffset, header.width, header.height);
+    return true;
+  }
+
+  void Font::GenerateAtlas(const std::string& cacheFilename, uint64_t hash)
+  {
+    std::vector<msdf_atlas::GlyphGeometry> glyphs;
+    msdf_atlas::FontGeometry fontGeometry(&glyphs);
+    fontGeometry.loadCharset(font, 1.0, msdf_atlas::Charset::ASCII);
+    const double maxCornerAngle = 3.0;
+    for (msdf_atlas::GlyphGeometry& glyph : glyphs)
+    {
+      glyph.edgeColoring(&msdfgen::edgeColoringInkTrap, maxCornerAngle, 0);
+    }
+    msdf_atlas::TightAtlasPacker packer;
+    packer.setDimensionsConstraint(msdf_atlas::TightAtlasPacker::DimensionsConstraint::SQUARE);
+    packer.setMinimumScale(ATLAS_MIN_SCALE);
+    packer.setPixelRange(ATLAS_PIXEL_RANGE);
+    packer.setMiterLimit(ATLAS_MITER_LIMIT);
+    packer.setPadding(ATLAS_PADDING);
+    packer.pack(glyphs.data(), glyphs.size());
+
+    int width = 0, height = 0;
+    packer.getDimensions(width, height);
+
+    msdf_atlas::
+      ImmediateAtlasGenerator<float, 3, msdf_atlas::msdfGenerator, msdf_atlas::BitmapAtlasStorage<msdf_atlas::byte, 3>>
+        generator(width, height);
+    msdf_atlas::GeneratorAttributes attributes;
+    generator.setAttributes(attributes);
+    generator.setThreadCount(4);
+    generator.generate(glyphs.data(), glyphs.size());
+
+    this->glyphs.resize(NUM_GLYPHS);
+    validGlyphs.assign(NUM_GLYPHS, false);
+    std::vector<AtlasCacheGlyph> cachedGlyphs;
+    for (msdf_atlas::GlyphGeometry& glyphGeom : glyphs)
+    {
+      Glyph glyph;
+      glyph.advance = glyphGeom.getAdvance();
+      double l, b, r, t;
+      glyphGeom.getQuadPlaneBounds(l, b, r, t);
+      glyph.boundingBox = BoundingBox{(float)l, (float)b, (float)r, (float)t};
+      glyphGeom.getQuadAtlasBounds(l, b, r, t);
+      glyph.texCoordBoundingBox = BoundingBox{(float)l / width, (float)b / height, (float)r / width, (float)t / height};
+      int index = glyphGeom.getCodepoint();
+      if (index >= NUM_GLYPHS)
+        continue;
+      this->glyphs[index] = glyph;
+      validGlyphs[index] = true;
+      cachedGlyphs.emplace_back(
+        AtlasCacheGlyph{(uint32_t)index, glyph.advance, glyph.boundingBox, glyph.texCoordBoundingBox});
+    }
+    lineHeight = fontGeometry.getMetrics().lineHeight;
+    baseHeight = fontGeometry.getMetrics().ascenderY;
+    geometryScale = fontGeometry.getGeometryScale();
+
+    // The cache file is laid out as the header, the glyphs and then the RGBA pixels, so that it can be uploaded as is
+    AtlasCacheHeader header{
+      ATLAS_CACHE_MAGIC, (uint32_t)cachedGlyphs.size(), hash, geometryScale, width, height, lineHeight, baseHeight};
+    size_t glyphsOffset = sizeof(header);
+    size_t pixelsOffset = glyphsOffset + cachedGlyphs.size() * sizeof(AtlasCacheGlyph);
+    std::vector<char> data(pixelsOffset + (size_t)width * height * 4);
+    memcpy(data.data(), &header, sizeof(header));
+    memcpy(data.data() + glyphsOffset, cachedGlyphs.data(), cachedGlyphs.size() * sizeof(AtlasCacheGlyph));
+
+    msdf_atlas::BitmapAtlasStorage<msdf_atlas::byte, 3> pixels = generator.atlasStorage();
+    msdfgen::Bitmap<msdf_atlas::byte, 3> bitmap = (msdfgen::Bitmap<msdf_atlas::byte, 3>)pixels;
+    uint8_t* rgbaData = (uint8_t*)data.data() + pixelsOffset;
+    for (int i = 0; i < width * height; i++)
+    {
+      rgbaData[i * 4] = bitmap[i * 3];
+      rgbaData[i * 4 + 1] = bitmap[i * 3 + 1];
+      rgbaData[i * 4 + 2] = bitmap[i * 3 + 2];
+      rgbaData[i * 4 + 3] = 255;
+    }
+    InitializeTextureImageFromData(rgbaData, width, height);
+    FileSystem::WriteFile(cacheFilename, data.data(), data.size());
+  }
+
+  void Font::InitializeGlyphTable()
+  {
+    std::vector<BoundingBox> table(NUM_GLYPHS * 2, BoundingBox{0.0f});
+    for (int i = 0; i < NUM_GLYPHS; i++)
+    {
+      if (!validGlyphs[i])
+        continue;
+      table[i * 2] = glyphs[i].boundingBox;
+      table[i * 2 + 1] = glyphs[i].texCoordBoundingBox;
+    }
+    glyphTable =
+      std::make_unique<StorageBuffer>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, table.size() * sizeof(BoundingBox), 1);
+    glyphTable->UpdateStaging(table.data());
+  }
+
   void Font::InitializeTextureImageFromData(const uint8_t* rgbaData, int width, int height)
   {
     VkDeviceSize bufferSize = width * height * 4;
@@ -179,5 +319,6 @@ namespace Copium
     Image::TransitionImageLayout(
       image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     imageView = Image::InitializeImageView(image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT);
+    InitializeBindlessIndex();
   }
 }
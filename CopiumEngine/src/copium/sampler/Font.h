@@ -1,9 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+
+#include "copium/buffer/StorageBuffer.h"
 #include "copium/sampler/Glyph.h"
+#include "copium/sampler/GlyphCache.h"
 #include "copium/sampler/Sampler.h"
 #include "copium/util/BoundingBox.h"
 
+namespace msdfgen
+{
+  class FreetypeHandle;
+}
+
 namespace Copium
 {
   class Font : public Sampler
@@ -15,9 +25,47 @@ namespace Copium
     VkDeviceMemory imageMemory;
     VkImageView imageView;
 
-    std::map<char, Glyph> glyphs;
+    static constexpr int NUM_GLYPHS = 128;  // ASCII, indexed by the character, other glyphs are generated on use
+    static std::atomic<uint64_t> nextInstanceId;
+
+    // Changing any of these invalidates the cached atlases in .cache/
+    static constexpr uint32_t ATLAS_CACHE_MAGIC = 0x41465043;  // "CPFA"
+    static constexpr int ATLAS_CACHE_VERSION = 1;
+    static constexpr double ATLAS_MIN_SCALE = 64.0;
+    static constexpr double ATLAS_PIXEL_RANGE = 2.0;
+    static constexpr double ATLAS_MITER_LIMIT = 1.0;
+    static constexpr int ATLAS_PADDING = 2;
+
+    struct AtlasCacheHeader
+    {
+      uint32_t magic;
+      uint32_t glyphCount;
+      uint64_t hash;  // Of the font file and the atlas parameters
+      double geometryScale;
+      int32_t width;
+      int32_t height;
+      float lineHeight;
+      float baseHeight;
+    };
+
+    struct AtlasCacheGlyph
+    {
+      uint32_t codepoint;
+      float advance;
+      BoundingBox boundingBox;
+      BoundingBox texCoordBoundingBox;
+    };
+
+    msdfgen::FreetypeHandle* freetype;
+    msdfgen::FontHandle* font;
+    std::vector<Glyph> glyphs;
+    std::vector<bool> validGlyphs;
+    std::unique_ptr<GlyphCache> glyphCache;
+    std::unique_ptr<StorageBuffer> glyphTable;
     float lineHeight;
     float baseHeight;
+    double geometryScale;
+    uint64_t instanceId;
 
   public:
     Font(const MetaFile& metaFile);
@@ -25,13 +73,28 @@ namespace Copium
 
     VkDescriptorImageInfo GetDescriptorImageInfo(int index) const override;
 
-    const Glyph& GetGlyph(char c) const;
+    // Glyphs which are not generated yet are empty, glyphs missing in the font are replaced with '?'
+    Glyph GetGlyph(uint32_t codepoint) const;
+    // Changes whenever glyphs are generated or evicted, anything storing glyphs should then be recreated
+    int GetGlyphGeneration() const;
+    // Unique for every loaded font. Unlike the address or the uuid it is never reused, not even when the same font
+    // asset is loaded again
+    uint64_t GetInstanceId() const;
+    void TouchGlyphCells(const std::vector<int>& cells) const;
+    // Bounds and texture coordinates of the atlas glyphs as two vec4 (l, b, r, t) per glyph, used by TextRenderer
+    const StorageBuffer& GetGlyphTable() const;
+    // Glyphs which are not in the atlas are replaced with '?'
+    int GetGlyphTableIndex(uint32_t codepoint) const;
     float GetLineHeight() const;
     float GetBaseHeight() const;
 
     BoundingBox GetTextBoundingBox(const std::string& str, float size) const;
 
   private:
+    // Returns false if the cache was generated from a different font file or with different parameters
+    bool LoadCachedAtlas(const std::string& cacheFilename, uint64_t hash);
+    void GenerateAtlas(const std::string& cacheFilename, uint64_t hash);
     void InitializeTextureImageFromData(const uint8_t* rgbaData, int width, int height);
+    void InitializeGlyphTable();
   };
 }
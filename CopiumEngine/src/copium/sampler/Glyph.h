@@ -4,10 +4,14 @@
 
 namespace Copium
 {
+  class Sampler;
+
   struct Glyph
   {
     float advance;
     BoundingBox boundingBox;
     BoundingBox texCoordBoundingBox;
+    const Sampler* sampler = nullptr;  // Page of dynamically generated glyphs, nullptr if in the font's own atlas
+    int cell = -1;                     // Cell within the GlyphCache, -1 if not dynamically generated
   };
 }
@@ -0,0 +1,347 @@
+#include "copium/sampler/GlyphCache.h"
+
+#include <algorithm>
+#include <msdf-atlas-gen/msdf-atlas-gen.h>
+
+#include "copium/buffer/Buffer.h"
+#include "copium/buffer/CommandBufferScoped.h"
+#include "copium/core/Vulkan.h"
+#include "copium/sampler/Texture2D.h"
+
+namespace Copium
+{
+  std::mutex GlyphCache::instancesMutex;
+  std::vector<GlyphCache*> GlyphCache::instances;
+
+  GlyphCache::GlyphCache(msdfgen::FontHandle* font, double geometryScale, const SamplerCreator& samplerCreator)
+    : font{font},
+      geometryScale{geometryScale},
+      samplerCreator{samplerCreator},
+      worker{&GlyphCache::Run, this}
+  {
+    std::lock_guard<std::mutex> lock{instancesMutex};
+    instances.emplace_back(this);
+  }
+
+  GlyphCache::~GlyphCache()
+  {
+    {
+      std::lock_guard<std::mutex> lock{instancesMutex};
+      instances.erase(std::find(instances.begin(), instances.end(), this));
+    }
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      running = false;
+    }
+    condition.notify_one();
+    worker.join();
+  }
+
+  GlyphStatus GlyphCache::GetGlyph(uint32_t codepoint, Glyph& glyph)
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    auto it = glyphs.find(codepoint);
+    if (it != glyphs.end())
+    {
+      cells[it->second.cell].lastUsedFrame = Vulkan::GetSwapChain().GetFrameCount();
+      glyph = it->second;
+      return GlyphStatus::Loaded;
+    }
+    if (missingGlyphs.count(codepoint) != 0)
+      return GlyphStatus::Missing;
+
+    if (requestedGlyphs.emplace(codepoint).second)
+    {
+      jobs.emplace_back(codepoint);
+      condition.notify_one();
+    }
+    return GlyphStatus::Pending;
+  }
+
+  void GlyphCache::TouchCells(const std::vector<int>& cells)
+  {
+    uint64_t frame = Vulkan::GetSwapChain().GetFrameCount();
+    std::lock_guard<std::mutex> lock{mutex};
+    for (int cell : cells)
+      this->cells[cell].lastUsedFrame = frame;
+  }
+
+  int GlyphCache::GetGeneration() const
+  {
+    return generation;
+  }
+
+  void GlyphCache::UpdateAll()
+  {
+    std::lock_guard<std::mutex> lock{instancesMutex};
+    for (GlyphCache* instance : instances)
+      instance->Update();
+  }
+
+  void GlyphCache::Update()
+  {
+    std::vector<GeneratedGlyph> generated;
+    std::vector<CellUpload> uploads;
+    std::vector<std::pair<uint32_t, Glyph>> uploadedGlyphs;
+    size_t newPageIndex;
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      if (generatedGlyphs.empty())
+        return;
+
+      generated = std::move(generatedGlyphs);
+      generatedGlyphs.clear();
+      newPageIndex = pages.size();
+      for (GeneratedGlyph& generatedGlyph : generated)
+      {
+        if (!generatedGlyph.found)
+        {
+          requestedGlyphs.erase(generatedGlyph.codepoint);
+          missingGlyphs.emplace(generatedGlyph.codepoint);
+          continue;
+        }
+
+        // If every cell is used by a frame in flight the glyph is requested again on its next use
+        int cell = AllocateCell();
+        if (cell == -1)
+        {
+          requestedGlyphs.erase(generatedGlyph.codepoint);
+          continue;
+        }
+        uploads.emplace_back(CellUpload{cell, generatedGlyph.rgbaData.data()});
+        uploadedGlyphs.emplace_back(generatedGlyph.codepoint, GetCellGlyph(generatedGlyph.glyph, cell));
+        cells[cell] = Cell{generatedGlyph.codepoint, Vulkan::GetSwapChain().GetFrameCount(), true};
+      }
+    }
+
+    // The submit waits for the queue to be idle, so it is done without holding the mutex to not block GetGlyph. The
+    // glyphs stay requested until they are added below, so they aren't generated again in the meantime
+    if (!uploads.empty())
+      UploadCells(uploads, newPageIndex);
+
+    std::lock_guard<std::mutex> lock{mutex};
+    for (auto& [codepoint, glyph] : uploadedGlyphs)
+    {
+      requestedGlyphs.erase(codepoint);
+      glyphs[codepoint] = glyph;
+    }
+    generation++;
+  }
+
+  Glyph GlyphCache::GetCellGlyph(const Glyph& generated, int cell) const
+  {
+    int x = (cell % CELLS_PER_PAGE) % CELLS_PER_ROW * CELL_SIZE;
+    int y = (cell % CELLS_PER_PAGE) / CELLS_PER_ROW * CELL_SIZE;
+    Glyph glyph = generated;
+    const BoundingBox& texCoords = generated.texCoordBoundingBox;
+    glyph.texCoordBoundingBox = BoundingBox{(texCoords.l + x) / PAGE_SIZE,
+                                            (texCoords.b + y) / PAGE_SIZE,
+                                            (texCoords.r + x) / PAGE_SIZE,
+                                            (texCoords.t + y) / PAGE_SIZE};
+    glyph.sampler = pages[cell / CELLS_PER_PAGE].get();
+    glyph.cell = cell;
+    return glyph;
+  }
+
+  void GlyphCache::UploadCells(const std::vector<CellUpload>& uploads, size_t newPageIndex)
+  {
+    VkDeviceSize cellBufferSize = CELL_SIZE * CELL_SIZE * 4;
+    Buffer stagingBuffer{VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         uploads.size() * cellBufferSize,
+                         1};
+    uint8_t* data = (uint8_t*)stagingBuffer.Map();
+    std::vector<std::vector<VkBufferImageCopy>> pageRegions{pages.size()};
+    for (size_t i = 0; i < uploads.size(); i++)
+    {
+      memcpy(data + i * cellBufferSize, uploads[i].rgbaData, cellBufferSize);
+
+      int cellInPage = uploads[i].cell % CELLS_PER_PAGE;
+      VkBufferImageCopy region{};
+      region.bufferOffset = i * cellBufferSize;
+      region.bufferRowLength = 0;
+      region.bufferImageHeight = 0;
+      region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      region.imageSubresource.mipLevel = 0;
+      region.imageSubresource.baseArrayLayer = 0;
+      region.imageSubresource.layerCount = 1;
+      region.imageOffset = {cellInPage % CELLS_PER_ROW * CELL_SIZE, cellInPage / CELLS_PER_ROW * CELL_SIZE, 0};
+      region.imageExtent = {CELL_SIZE, CELL_SIZE, 1};
+      pageRegions[uploads[i].cell / CELLS_PER_PAGE].emplace_back(region);
+    }
+    stagingBuffer.Unmap();
+
+    std::vector<VkImageMemoryBarrier> toTransferBarriers;
+    std::vector<VkImageMemoryBarrier> toShaderBarriers;
+    for (size_t i = 0; i < pages.size(); i++)
+    {
+      if (pageRegions[i].empty())
+        continue;
+
+      // The previous content of new pages doesn't have to be kept, since cells are always uploaded as a whole
+      VkImageMemoryBarrier barrier{};
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.oldLayout = i >= newPageIndex ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image = pages[i]->GetImage();
+      barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      barrier.subresourceRange.baseMipLevel = 0;
+      barrier.subresourceRange.levelCount = 1;
+      barrier.subresourceRange.baseArrayLayer = 0;
+      barrier.subresourceRange.layerCount = 1;
+      barrier.srcAccessMask = i >= newPageIndex ? 0 : VK_ACCESS_SHADER_READ_BIT;
+      barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      toTransferBarriers.emplace_back(barrier);
+
+      barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      toShaderBarriers.emplace_back(barrier);
+    }
+
+    CommandBufferScoped commandBuffer{};
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         toTransferBarriers.size(),
+                         toTransferBarriers.data());
+    for (size_t i = 0; i < pages.size(); i++)
+    {
+      if (pageRegions[i].empty())
+        continue;
+      vkCmdCopyBufferToImage(commandBuffer,
+                             stagingBuffer,
+                             pages[i]->GetImage(),
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             pageRegions[i].size(),
+                             pageRegions[i].data());
+    }
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         toShaderBarriers.size(),
+                         toShaderBarriers.data());
+  }
+
+  void GlyphCache::Run()
+  {
+    while (true)
+    {
+      uint32_t codepoint;
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [this] { return !jobs.empty() || !running; });
+        if (!running)
+          return;
+        codepoint = jobs.front();
+        jobs.pop_front();
+      }
+
+      GeneratedGlyph generated = Generate(codepoint);
+
+      std::lock_guard<std::mutex> lock{mutex};
+      generatedGlyphs.emplace_back(std::move(generated));
+    }
+  }
+
+  GlyphCache::GeneratedGlyph GlyphCache::Generate(uint32_t codepoint)
+  {
+    GeneratedGlyph generated{codepoint, false};
+    msdf_atlas::GlyphGeometry geometry;
+    if (!geometry.load(font, geometryScale, codepoint))
+      return generated;
+
+    const double maxCornerAngle = 3.0;
+    const double miterLimit = 1.0;
+    geometry.edgeColoring(&msdfgen::edgeColoringInkTrap, maxCornerAngle, 0);
+
+    // One pixel border within the cell avoids bleeding from neighbouring cells when filtering
+    const int maxBoxSize = CELL_SIZE - 2;
+    double scale = GLYPH_SCALE;
+    int width, height;
+    geometry.wrapBox(scale, PIXEL_RANGE / scale, miterLimit);
+    geometry.getBoxSize(width, height);
+    while (width > maxBoxSize || height > maxBoxSize)
+    {
+      scale *= 0.95 * maxBoxSize / std::max(width, height);
+      geometry.wrapBox(scale, PIXEL_RANGE / scale, miterLimit);
+      geometry.getBoxSize(width, height);
+    }
+    geometry.placeBox(1, 1);
+
+    msdf_atlas::
+      ImmediateAtlasGenerator<float, 3, msdf_atlas::msdfGenerator, msdf_atlas::BitmapAtlasStorage<msdf_atlas::byte, 3>>
+        generator(CELL_SIZE, CELL_SIZE);
+    msdf_atlas::GeneratorAttributes attributes;
+    generator.setAttributes(attributes);
+    generator.setThreadCount(1);
+    generator.generate(&geometry, 1);
+
+    msdfgen::Bitmap<msdf_atlas::byte, 3> bitmap = (msdfgen::Bitmap<msdf_atlas::byte, 3>)generator.atlasStorage();
+    generated.rgbaData.resize(CELL_SIZE * CELL_SIZE * 4);
+    for (int i = 0; i < CELL_SIZE * CELL_SIZE; i++)
+    {
+      generated.rgbaData[i * 4] = bitmap[i * 3];
+      generated.rgbaData[i * 4 + 1] = bitmap[i * 3 + 1];
+      generated.rgbaData[i * 4 + 2] = bitmap[i * 3 + 2];
+      generated.rgbaData[i * 4 + 3] = 255;
+    }
+
+    generated.glyph.advance = geometry.getAdvance();
+    double l, b, r, t;
+    geometry.getQuadPlaneBounds(l, b, r, t);
+    generated.glyph.boundingBox = BoundingBox{(float)l, (float)b, (float)r, (float)t};
+    geometry.getQuadAtlasBounds(l, b, r, t);
+    generated.glyph.texCoordBoundingBox = BoundingBox{(float)l, (float)b, (float)r, (float)t};
+    generated.found = true;
+    return generated;
+  }
+
+  int GlyphCache::AllocateCell()
+  {
+    for (int i = 0; i < cells.size(); i++)
+    {
+      if (!cells[i].used)
+        return i;
+    }
+
+    if (pages.size() < MAX_NUM_PAGES)
+    {
+      // Uploaded together with its first cells in UploadCells
+      pages.emplace_back(std::make_unique<Texture2D>(PAGE_SIZE, PAGE_SIZE, samplerCreator));
+      int cell = cells.size();
+      cells.resize(cells.size() + CELLS_PER_PAGE, Cell{0, 0, false});
+      return cell;
+    }
+
+    // Evict the least recently used glyph which isn't referenced by a frame in flight
+    uint64_t frame = Vulkan::GetSwapChain().GetFrameCount();
+    int leastRecentlyUsed = -1;
+    for (int i = 0; i < cells.size(); i++)
+    {
+      if (cells[i].lastUsedFrame + SwapChain::MAX_FRAMES_IN_FLIGHT > frame)
+        continue;
+      if (leastRecentlyUsed == -1 || cells[i].lastUsedFrame < cells[leastRecentlyUsed].lastUsedFrame)
+        leastRecentlyUsed = i;
+    }
+    if (leastRecentlyUsed != -1)
+    {
+      glyphs.erase(cells[leastRecentlyUsed].codepoint);
+      cells[leastRecentlyUsed].used = false;
+    }
+    return leastRecentlyUsed;
+  }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "copium/sampler/Glyph.h"
+#include "copium/sampler/SamplerCreator.h"
+#include "copium/util/Common.h"
+#include "copium/util/Enum.h"
+
+#define CP_GLYPH_STATUS_ENUMS Loaded, Pending, Missing
+CP_ENUM_CREATOR(Copium, GlyphStatus, CP_GLYPH_STATUS_ENUMS);
+
+namespace msdfgen
+{
+  class FontHandle;
+}
+
+namespace Copium
+{
+  class Texture2D;
+
+  // Generates glyphs on first use on a worker thread into fixed size cells of atlas pages.
+  // Generated glyphs are uploaded once per frame in UpdateAll, when all pages are full the least recently used glyph
+  // which isn't referenced by a frame in flight is evicted
+  class GlyphCache final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(GlyphCache);
+
+  private:
+    static constexpr int PAGE_SIZE = 1024;
+    static constexpr int CELL_SIZE = 64;
+    static constexpr int CELLS_PER_ROW = PAGE_SIZE / CELL_SIZE;
+    static constexpr int CELLS_PER_PAGE = CELLS_PER_ROW * CELLS_PER_ROW;
+    static constexpr int MAX_NUM_PAGES = 4;
+    static constexpr double GLYPH_SCALE = 48.0;  // Pixels per em, lowered for glyphs which don't fit in a cell
+    static constexpr double PIXEL_RANGE = 2.0;
+
+    struct Cell
+    {
+      uint32_t codepoint;
+      uint64_t lastUsedFrame;
+      bool used;
+    };
+
+    struct GeneratedGlyph
+    {
+      uint32_t codepoint;
+      bool found;
+      Glyph glyph;  // Texture coordinates are in pixels relative to the cell
+      std::vector<uint8_t> rgbaData;
+    };
+
+    struct CellUpload
+    {
+      int cell;
+      const uint8_t* rgbaData;
+    };
+
+    static std::mutex instancesMutex;
+    static std::vector<GlyphCache*> instances;
+
+    msdfgen::FontHandle* font;
+    double geometryScale;
+    SamplerCreator samplerCreator;
+
+    std::vector<std::unique_ptr<Texture2D>> pages;
+    std::vector<Cell> cells;
+    std::unordered_map<uint32_t, Glyph> glyphs;
+    std::unordered_set<uint32_t> requestedGlyphs;
+    std::unordered_set<uint32_t> missingGlyphs;
+    std::atomic<int> generation{0};
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<uint32_t> jobs;
+    std::vector<GeneratedGlyph> generatedGlyphs;
+    bool running = true;
+    std::thread worker;
+
+  public:
+    // The font handle must outlive the cache, it is only accessed from the worker thread
+    GlyphCache(msdfgen::FontHandle* font, double geometryScale, const SamplerCreator& samplerCreator);
+    ~GlyphCache();
+
+    // Requests the glyph to be generated if it is not loaded
+    GlyphStatus GetGlyph(uint32_t codepoint, Glyph& glyph);
+    // Keeps the glyphs in the given cells from being evicted, for layouts which don't call GetGlyph every frame
+    void TouchCells(const std::vector<int>& cells);
+    // Changes whenever glyphs are added or evicted
+    int GetGeneration() const;
+
+    // Uploads the glyphs generated since the last call, called by the SwapChain outside of command buffer recording
+    static void UpdateAll();
+
+  private:
+    void Update();
+    // Texture coordinates of the generated glyph within the page of the cell
+    Glyph GetCellGlyph(const Glyph& generated, int cell) const;
+    // Copies all cells through one staging buffer and one command buffer. Pages from newPageIndex and onwards have
+    // not been uploaded to before
+    void UploadCells(const std::vector<CellUpload>& uploads, size_t newPageIndex);
+    void Run();
+    GeneratedGlyph Generate(uint32_t codepoint);
+    int AllocateCell();
+  };
+}
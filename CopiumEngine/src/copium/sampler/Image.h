@@ -22,7 +22,10 @@ namespace Copium
                                 VkDeviceMemory* imageMemory);
     static VkImageView InitializeImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
     static void TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
-    static void CopyBufferToImage(const Buffer& buffer, VkImage image, uint32_t width, uint32_t height);
+    static void CopyBufferToImage(
+      const Buffer& buffer, VkImage image, uint32_t width, uint32_t height, int32_t x = 0, int32_t y = 0);
+    // The image must be in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+    static void CopyImageToBuffer(VkImage image, const Buffer& buffer, uint32_t width, uint32_t height);
     static VkFormat SelectDepthFormat();
 
   private:
@@ -11,6 +11,12 @@ namespace Copium
 
   Sampler::~Sampler()
   {
+    if (bindlessIndex != -1)
+    {
+      int bindlessIndexCpy = bindlessIndex;
+      Vulkan::GetDevice().QueueIdleCommand([bindlessIndexCpy]()
+                                           { Vulkan::GetBindlessDescriptorSet().RemoveSampler(bindlessIndexCpy); });
+    }
     VkSampler samplerCpy = sampler;
     Vulkan::GetDevice().QueueIdleCommand([samplerCpy]()
                                          { vkDestroySampler(Vulkan::GetDevice(), samplerCpy, nullptr); });
@@ -42,6 +48,27 @@ namespace Copium
                  "Failed to initialize texture sampler");
   }
 
+  int Sampler::GetBindlessIndex() const
+  {
+    return bindlessIndex;
+  }
+
+  const Sampler& Sampler::GetRenderSampler() const
+  {
+    return *this;
+  }
+
+  glm::vec2 Sampler::GetRenderTexCoord(const glm::vec2& texCoord) const
+  {
+    return texCoord;
+  }
+
+  void Sampler::InitializeBindlessIndex()
+  {
+    if (Vulkan::GetDevice().SupportsBindless())
+      bindlessIndex = Vulkan::GetBindlessDescriptorSet().AddSampler(*this);
+  }
+
   Sampler::operator VkSampler() const
   {
     return sampler;
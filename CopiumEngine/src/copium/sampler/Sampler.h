@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/glm.hpp>
 #include <vulkan/vulkan.hpp>
 
 #include "copium/asset/Asset.h"
@@ -14,6 +15,7 @@ namespace Copium
 
   protected:
     VkSampler sampler;
+    int bindlessIndex = -1;
 
   public:
     // Sampler();
@@ -21,8 +23,18 @@ namespace Copium
     virtual ~Sampler();
 
     virtual VkDescriptorImageInfo GetDescriptorImageInfo(int index) const = 0;
+    // Index into the bindless texture array, -1 if the sampler isn't part of it
+    int GetBindlessIndex() const;
+    // The sampler which should be bound when rendering, and the texture coordinates within it. These differ from the
+    // sampler itself when it is packed in a TextureAtlas
+    virtual const Sampler& GetRenderSampler() const;
+    virtual glm::vec2 GetRenderTexCoord(const glm::vec2& texCoord) const;
     operator VkSampler() const;
 
+  protected:
+    // Should be called by subclasses once their image view is created
+    void InitializeBindlessIndex();
+
   private:
     void InitializeSampler(const SamplerCreator& samplerCreator);
   };
@@ -27,6 +27,11 @@ namespace Copium
     SamplerCreator::magFilter = magFilter;
   }
 
+  bool SamplerCreator::operator==(const SamplerCreator& rhs) const
+  {
+    return minFilter == rhs.minFilter && magFilter == rhs.magFilter && addressMode == rhs.addressMode;
+  }
+
   VkFilter SamplerCreator::GetFilterFromString(const std::string& str) const
   {
     if (str == "nearest")
@@ -22,6 +22,8 @@ namespace Copium
     void SetMinFilter(VkFilter minFilter);
     void SetMagFilter(VkFilter magFilter);
 
+    bool operator==(const SamplerCreator& rhs) const;
+
   private:
     VkFilter GetFilterFromString(const std::string& str) const;
     VkSamplerAddressMode GetAddressModeFromString(const std::string& str) const;
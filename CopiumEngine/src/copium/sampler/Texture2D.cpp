@@ -11,9 +11,10 @@ namespace Copium
   Texture2D::Texture2D(const MetaFile& metaFile)
     : Sampler{metaFile.GetMetaClass("Texture2D")}
   {
-    const std::string& filepath = metaFile.GetMetaClass("Texture2D").GetValue("filepath");
+    const MetaFileClass& metaClass = metaFile.GetMetaClass("Texture2D");
+    const std::string& filepath = metaClass.GetValue("filepath");
     CP_DEBUG("Loading texture file: %s", filepath.c_str());
-    InitializeTextureImageFromFile(filepath);
+    InitializeTextureImageFromFile(filepath, metaClass.GetValue("atlas", "false") == "true", SamplerCreator{metaClass});
   }
 
   Texture2D::Texture2D(const std::vector<uint8_t>& rgbaData,
@@ -31,8 +32,24 @@ namespace Copium
     InitializeTextureImageFromData(rgbaData.data(), width, height);
   }
 
+  Texture2D::Texture2D(int width, int height, const SamplerCreator& samplerCreator)
+    : Sampler{samplerCreator},
+      width{width},
+      height{height}
+  {
+    InitializeTextureImage(width, height);
+    imageView = Image::InitializeImageView(image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT);
+    InitializeBindlessIndex();
+  }
+
   Texture2D::~Texture2D()
   {
+    if (atlasPage)
+    {
+      Vulkan::GetTextureAtlas().Remove(atlasPage);
+      return;
+    }
+
     VkImage imageCpy = image;
     VkDeviceMemory imageMemoryCpy = imageMemory;
     VkImageView imageViewCpy = imageView;
@@ -47,6 +64,9 @@ namespace Copium
 
   VkDescriptorImageInfo Texture2D::GetDescriptorImageInfo(int index) const
   {
+    // The page would be sampled with the texture coordinates of the whole texture
+    CP_ASSERT(!atlasPage, "Texture is packed in an atlas, bind GetRenderSampler and use GetRenderTexCoord instead");
+
     VkDescriptorImageInfo imageInfo{};
     imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     imageInfo.sampler = sampler;
@@ -55,6 +75,40 @@ namespace Copium
     return imageInfo;
   }
 
+  const Sampler& Texture2D::GetRenderSampler() const
+  {
+    if (atlasPage)
+      return *atlasPage;
+    return *this;
+  }
+
+  glm::vec2 Texture2D::GetRenderTexCoord(const glm::vec2& texCoord) const
+  {
+    return atlasTexCoordOffset + texCoord * atlasTexCoordScale;
+  }
+
+  void Texture2D::Update(const uint8_t* rgbaData, int x, int y, int width, int height)
+  {
+    CP_ASSERT(!atlasPage, "Cannot update a texture which is packed in an atlas");
+    CP_ASSERT(x >= 0 && y >= 0 && x + width <= this->width && y + height <= this->height,
+              "Update region is out of bounds");
+
+    VkDeviceSize bufferSize = width * height * 4;
+    Buffer stagingBuffer{VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         bufferSize,
+                         1};
+    void* data = stagingBuffer.Map();
+    memcpy(data, rgbaData, bufferSize);
+    stagingBuffer.Unmap();
+
+    Image::TransitionImageLayout(
+      image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    Image::CopyBufferToImage(stagingBuffer, image, width, height, x, y);
+    Image::TransitionImageLayout(
+      image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  }
+
   int Texture2D::GetWidth() const
   {
     return width;
@@ -65,7 +119,14 @@ namespace Copium
     return height;
   }
 
-  void Texture2D::InitializeTextureImageFromFile(const std::string& filename)
+  VkImage Texture2D::GetImage() const
+  {
+    return image;
+  }
+
+  void Texture2D::InitializeTextureImageFromFile(const std::string& filename,
+                                                 bool atlas,
+                                                 const SamplerCreator& samplerCreator)
   {
     stbi_set_flip_vertically_on_load(true);
     int texWidth;
@@ -75,7 +136,25 @@ namespace Copium
 
     CP_ASSERT(pixels, "Failed to load texture image");
 
-    InitializeTextureImageFromData(pixels, texWidth, texHeight);
+    if (atlas && samplerCreator.addressMode != VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
+    {
+      CP_WARN("Only textures which clamp to edge can be packed in an atlas: %s", filename.c_str());
+      atlas = false;
+    }
+
+    if (atlas && TextureAtlas::CanAdd(texWidth, texHeight))
+    {
+      TextureAtlas::Region region = Vulkan::GetTextureAtlas().Add(pixels, texWidth, texHeight, samplerCreator);
+      atlasPage = region.page;
+      atlasTexCoordOffset = region.texCoordOffset;
+      atlasTexCoordScale = region.texCoordScale;
+    }
+    else
+    {
+      if (atlas)
+        CP_WARN("Texture is too big to be packed in an atlas: %s", filename.c_str());
+      InitializeTextureImageFromData(pixels, texWidth, texHeight);
+    }
     width = texWidth;
     height = texHeight;
 
@@ -93,6 +172,18 @@ namespace Copium
     memcpy(data, rgbaData, bufferSize);
     stagingBuffer.Unmap();
 
+    InitializeTextureImage(width, height);
+    Image::TransitionImageLayout(
+      image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    Image::CopyBufferToImage(stagingBuffer, image, width, height);
+    Image::TransitionImageLayout(
+      image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    imageView = Image::InitializeImageView(image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT);
+    InitializeBindlessIndex();
+  }
+
+  void Texture2D::InitializeTextureImage(int width, int height)
+  {
     Image::InitializeImage(width,
                            height,
                            VK_FORMAT_R8G8B8A8_UNORM,
@@ -101,11 +192,5 @@ namespace Copium
                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                            &image,
                            &imageMemory);
-    Image::TransitionImageLayout(
-      image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    Image::CopyBufferToImage(stagingBuffer, image, width, height);
-    Image::TransitionImageLayout(
-      image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    imageView = Image::InitializeImageView(image, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_ASPECT_COLOR_BIT);
   }
 }
@@ -10,25 +10,40 @@ namespace Copium
     CP_DELETE_COPY_AND_MOVE_CTOR(Texture2D);
 
   private:
-    VkImage image;
-    VkDeviceMemory imageMemory;
-    VkImageView imageView;
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+    VkImageView imageView = VK_NULL_HANDLE;
 
     int width;
     int height;
 
+    // Set if the texture is packed in a TextureAtlas page instead of having its own image
+    const Texture2D* atlasPage = nullptr;
+    glm::vec2 atlasTexCoordOffset{0, 0};
+    glm::vec2 atlasTexCoordScale{1, 1};
+
   public:
     Texture2D(const MetaFile& metaFile);
     Texture2D(const std::vector<uint8_t>& rgbaData, int width, int height, const SamplerCreator& samplerCreator);
+    // Creates the image without any data, it is in VK_IMAGE_LAYOUT_UNDEFINED until the owner uploads to it
+    Texture2D(int width, int height, const SamplerCreator& samplerCreator);
     ~Texture2D() override;
 
+    // Asserts if the texture is packed in an atlas, since it has no image of its own
     VkDescriptorImageInfo GetDescriptorImageInfo(int index) const override;
+    const Sampler& GetRenderSampler() const override;
+    glm::vec2 GetRenderTexCoord(const glm::vec2& texCoord) const override;
+
+    // Uploads rgbaData to the given region of the image
+    void Update(const uint8_t* rgbaData, int x, int y, int width, int height);
 
     int GetWidth() const;
     int GetHeight() const;
+    VkImage GetImage() const;
 
   private:
-    void InitializeTextureImageFromFile(const std::string& filename);
+    void InitializeTextureImageFromFile(const std::string& filename, bool atlas, const SamplerCreator& samplerCreator);
     void InitializeTextureImageFromData(const uint8_t* rgbaData, int width, int height);
+    void InitializeTextureImage(int width, int height);
   };
 }
@@ -0,0 +1,90 @@
+#include "copium/sampler/TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <msdf-atlas-gen/msdf-atlas-gen.h>
+
+#include "copium/sampler/Texture2D.h"
+
+namespace Copium
+{
+  TextureAtlas::TextureAtlas() = default;
+
+  TextureAtlas::~TextureAtlas() = default;
+
+  bool TextureAtlas::CanAdd(int width, int height)
+  {
+    return width <= MAX_TEXTURE_SIZE && height <= MAX_TEXTURE_SIZE;
+  }
+
+  TextureAtlas::Region TextureAtlas::Add(const uint8_t* rgbaData,
+                                         int width,
+                                         int height,
+                                         const SamplerCreator& samplerCreator)
+  {
+    CP_ASSERT(CanAdd(width, height), "Texture is too big to be added to the atlas (%dx%d)", width, height);
+    CP_ASSERT(samplerCreator.addressMode == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+              "Only textures which clamp to edge can be added to the atlas");
+
+    msdf_atlas::Rectangle rect{0, 0, width + 2 * PADDING, height + 2 * PADDING};
+    Page* page = nullptr;
+    for (auto& p : pages)
+    {
+      if (p.samplerCreator == samplerCreator && p.packer->pack(&rect, 1) == 0)
+      {
+        page = &p;
+        break;
+      }
+    }
+    if (!page)
+    {
+      page = &AddPage(samplerCreator);
+      CP_ASSERT(page->packer->pack(&rect, 1) == 0, "Failed to pack texture into an empty atlas page");
+    }
+
+    std::vector<uint8_t> paddedData(rect.w * rect.h * 4);
+    for (int y = 0; y < rect.h; y++)
+    {
+      int srcY = std::clamp(y - PADDING, 0, height - 1);
+      for (int x = 0; x < rect.w; x++)
+      {
+        int srcX = std::clamp(x - PADDING, 0, width - 1);
+        memcpy(&paddedData[(x + y * rect.w) * 4], &rgbaData[(srcX + srcY * width) * 4], 4);
+      }
+    }
+    page->texture->Update(paddedData.data(), rect.x, rect.y, rect.w, rect.h);
+    page->textureCount++;
+
+    return Region{page->texture.get(),
+                  glm::vec2{rect.x + PADDING, rect.y + PADDING} / (float)PAGE_SIZE,
+                  glm::vec2{width, height} / (float)PAGE_SIZE};
+  }
+
+  void TextureAtlas::Remove(const Texture2D* page)
+  {
+    for (auto it = pages.begin(); it != pages.end(); ++it)
+    {
+      if (it->texture.get() != page)
+        continue;
+
+      it->textureCount--;
+      if (it->textureCount == 0)
+        pages.erase(it);
+      return;
+    }
+    CP_ABORT("Atlas page not found");
+  }
+
+  TextureAtlas::Page& TextureAtlas::AddPage(const SamplerCreator& samplerCreator)
+  {
+    Page page;
+    page.texture = std::make_unique<Texture2D>(
+      std::vector<uint8_t>(PAGE_SIZE * PAGE_SIZE * 4, 0), PAGE_SIZE, PAGE_SIZE, samplerCreator);
+    page.packer = std::make_unique<msdf_atlas::RectanglePacker>(PAGE_SIZE, PAGE_SIZE);
+    page.samplerCreator = samplerCreator;
+    page.textureCount = 0;
+    pages.emplace_back(std::move(page));
+    CP_DEBUG("Added texture atlas page, page count=%d", (int)pages.size());
+    return pages.back();
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "copium/sampler/SamplerCreator.h"
+#include "copium/util/Common.h"
+
+namespace msdf_atlas
+{
+  class RectanglePacker;
+}
+
+namespace Copium
+{
+  class Texture2D;
+
+  // Packs small textures into large shared pages, so that they can be drawn in the same batch.
+  // Textures opt in with "atlas = true" in their meta file, only textures with the same sampler settings share a page.
+  // Repeating and mirroring would sample the neighbouring textures, so only textures which clamp to edge are packed
+  class TextureAtlas final
+  {
+    CP_DELETE_COPY_AND_MOVE_CTOR(TextureAtlas);
+
+  public:
+    struct Region
+    {
+      const Texture2D* page;
+      glm::vec2 texCoordOffset;
+      glm::vec2 texCoordScale;
+    };
+
+  private:
+    static constexpr int PAGE_SIZE = 2048;
+    static constexpr int MAX_TEXTURE_SIZE = 256;
+    static constexpr int PADDING = 1;  // Edge pixels are extruded to avoid bleeding between textures when filtering
+
+    struct Page
+    {
+      std::unique_ptr<Texture2D> texture;
+      std::unique_ptr<msdf_atlas::RectanglePacker> packer;
+      SamplerCreator samplerCreator;
+      int textureCount;
+    };
+
+    std::vector<Page> pages;
+
+  public:
+    TextureAtlas();
+    ~TextureAtlas();
+
+    static bool CanAdd(int width, int height);
+    Region Add(const uint8_t* rgbaData, int width, int height, const SamplerCreator& samplerCreator);
+    // Pages are released when all of their textures are removed
+    void Remove(const Texture2D* page);
+
+  private:
+    Page& AddPage(const SamplerCreator& samplerCreator);
+  };
+}
@@ -0,0 +1,20 @@
+#include "copium/util/Hash.h"
+
+namespace Copium
+{
+  uint64_t Hash::Fnv1a(const void* data, size_t size, uint64_t hash)
+  {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3;
+    }
+    return hash;
+  }
+
+  uint64_t Hash::Fnv1a(const std::string_view& str, uint64_t hash)
+  {
+    return Fnv1a(str.data(), str.size(), hash);
+  }
+}
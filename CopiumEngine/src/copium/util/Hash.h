@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Stable 64-bit FNV-1a hashes, safe to store in files unlike std::hash
+  class Hash
+  {
+    CP_STATIC_CLASS(Hash);
+
+  public:
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+
+    static uint64_t Fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS);
+    static uint64_t Fnv1a(const std::string_view& str, uint64_t hash = FNV_OFFSET_BASIS);
+  };
+}
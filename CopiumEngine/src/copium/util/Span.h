@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "copium/util/Common.h"
+
+namespace Copium
+{
+  // Non-owning view of contiguous memory, stand-in for std::span until we move to C++20
+  template <typename T>
+  class Span
+  {
+  private:
+    T* ptr = nullptr;
+    size_t count = 0;
+
+  public:
+    Span() = default;
+
+    Span(T* ptr, size_t count)
+      : ptr{ptr},
+        count{count}
+    {
+    }
+
+    template <typename U>
+    Span(std::vector<U>& vector)
+      : ptr{vector.data()},
+        count{vector.size()}
+    {
+    }
+
+    template <typename U>
+    Span(const std::vector<U>& vector)
+      : ptr{vector.data()},
+        count{vector.size()}
+    {
+    }
+
+    T* data() const
+    {
+      return ptr;
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    bool empty() const
+    {
+      return count == 0;
+    }
+
+    T& operator[](size_t index) const
+    {
+      CP_ASSERT(index < count, "Index Out of Bound Exception");
+      return ptr[index];
+    }
+
+    T* begin() const
+    {
+      return ptr;
+    }
+
+    T* end() const
+    {
+      return ptr + count;
+    }
+  };
+}
@@ -34,4 +34,49 @@ namespace Copium
   {
     return Trim(std::string_view(str));
   }
+
+  uint32_t StringUtil::DecodeUtf8(const std::string& str, size_t& index)
+  {
+    static constexpr uint32_t REPLACEMENT_CHARACTER = 0xfffd;
+
+    uint8_t lead = str[index++];
+    if (lead < 0x80)
+      return lead;
+
+    int continuationBytes;
+    uint32_t codepoint;
+    if ((lead & 0xe0) == 0xc0)
+    {
+      continuationBytes = 1;
+      codepoint = lead & 0x1f;
+    }
+    else if ((lead & 0xf0) == 0xe0)
+    {
+      continuationBytes = 2;
+      codepoint = lead & 0x0f;
+    }
+    else if ((lead & 0xf8) == 0xf0)
+    {
+      continuationBytes = 3;
+      codepoint = lead & 0x07;
+    }
+    else
+    {
+      return REPLACEMENT_CHARACTER;
+    }
+
+    for (int i = 0; i < continuationBytes; i++)
+    {
+      if (index >= str.size() || ((uint8_t)str[index] & 0xc0) != 0x80)
+        return REPLACEMENT_CHARACTER;
+      codepoint = (codepoint << 6) | ((uint8_t)str[index++] & 0x3f);
+    }
+
+    // Reject overlong encodings, surrogates and out of range code points
+    static constexpr uint32_t MIN_CODEPOINTS[] = {0x0, 0x80, 0x800, 0x10000};
+    if (codepoint < MIN_CODEPOINTS[continuationBytes] || (codepoint >= 0xd800 && codepoint <= 0xdfff) ||
+        codepoint > 0x10ffff)
+      return REPLACEMENT_CHARACTER;
+    return codepoint;
+  }
 }
\ No newline at end of file
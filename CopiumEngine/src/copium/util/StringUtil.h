@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
 
@@ -15,6 +17,9 @@ namespace Copium
     static std::string_view Trim(const std::string& str);
     static std::string_view Trim(const std::string_view& str);
 
+    // Decodes the UTF-8 code point starting at index and moves index past it, invalid sequences decode to U+FFFD
+    static uint32_t DecodeUtf8(const std::string& str, size_t& index);
+
   private:
     static size_t GetTrimStartPos(const std::string_view& str);
     static size_t GetTrimEndPos(const std::string_view& str);